@@ -0,0 +1,107 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <units.hpp>
+#include <si.hpp>
+#include <chrono.hpp>
+#include <lut.hpp>
+
+/**
+ * Queries per second of unt::lut for scalar (one quantity per call) and batched
+ * (arrays of quantities, AVX2 gathers when compiled with -mavx2) lookups.
+ */
+
+namespace {
+
+constexpr std::size_t table_size = 256;
+constexpr std::size_t query_count = 1 << 20;
+constexpr int repetitions = 20;
+
+using pressure = si::units::pascal;
+using flow = decltype(si::instances::meter.pow<3> / si::instances::second)::type;
+
+template<typename T>
+struct tables {
+	T y[table_size];
+	T x[table_size];
+
+	tables() {
+		for (std::size_t i = 0; i < table_size; ++i) {
+			x[i] = static_cast<T>(i) * T(10);
+			y[i] = static_cast<T>(i * i) * T(0.001);
+		}
+	}
+};
+
+template<typename Fn>
+double queries_per_second(Fn fn) {
+	si::stopwatch<> watch;
+	for (int r = 0; r < repetitions; ++r) {
+		fn();
+	}
+	const auto elapsed = watch.elapsed();
+	return static_cast<double>(query_count) * repetitions / (static_cast<double>(elapsed.value) * decltype(elapsed)::unit_t::scale_factor);
+}
+
+template<typename T>
+void run(const char* name) {
+	static const tables<T> data;
+	const auto uniform = unt::make_uniform_lut<pressure, flow>(unt::quantity<pressure, T>(0), unt::quantity<pressure, T>(10), data.y);
+	const auto breakpoints = unt::make_breakpoint_lut<pressure, flow>(data.x, data.y);
+
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<T> dist(T(-10), T(table_size * 10 + 10));
+	std::vector<unt::quantity<pressure, T>> xs;
+	std::vector<T> ys(query_count);
+	xs.reserve(query_count);
+	for (std::size_t i = 0; i < query_count; ++i) {
+		xs.emplace_back(dist(rng));
+	}
+
+	volatile T sink = 0;
+	const double scalar = queries_per_second([&] {
+		T sum = 0;
+		for (const auto& x : xs) {
+			sum += uniform(x).value;
+		}
+		sink = sum;
+	});
+	const double batched = queries_per_second([&] {
+		uniform(xs.data(), ys.data(), xs.size());
+		sink = ys[query_count / 2];
+	});
+	const double cubic = queries_per_second([&] {
+		T sum = 0;
+		for (const auto& x : xs) {
+			sum += uniform.cubic(x).value;
+		}
+		sink = sum;
+	});
+	const double breakpoint_scalar = queries_per_second([&] {
+		T sum = 0;
+		for (const auto& x : xs) {
+			sum += breakpoints(x).value;
+		}
+		sink = sum;
+	});
+	const double breakpoint_batched = queries_per_second([&] {
+		breakpoints(xs.data(), ys.data(), xs.size());
+		sink = ys[query_count / 2];
+	});
+	(void)sink;
+
+	std::printf("%-6s uniform linear scalar   %8.1f Mq/s\n", name, scalar * 1e-6);
+	std::printf("%-6s uniform linear batched  %8.1f Mq/s\n", name, batched * 1e-6);
+	std::printf("%-6s uniform cubic scalar    %8.1f Mq/s\n", name, cubic * 1e-6);
+	std::printf("%-6s breakpoint scalar       %8.1f Mq/s\n", name, breakpoint_scalar * 1e-6);
+	std::printf("%-6s breakpoint batched      %8.1f Mq/s\n", name, breakpoint_batched * 1e-6);
+}
+
+}
+
+int main(void) {
+	run<float>("float");
+	run<double>("double");
+	return 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "units.hpp"
+#include "system.hpp"
+#include "si.hpp"
+
+// Centimetre-gram-second units differ from SI only by powers of ten, so they are
+// plain SI units and need no conversion step.
+namespace cgs {
+
+	UNITS_DECLARE_DERIVED(centimeter, si::instances::centi * si::instances::meter)
+	UNITS_DECLARE_DERIVED(gram,       si::instances::gram)
+	UNITS_DECLARE_DERIVED(second,     si::instances::second)
+
+	UNITS_DECLARE_DERIVED(gal,    centimeter / second.pow<2>)
+	UNITS_DECLARE_DERIVED(dyne,   gram * gal)
+	UNITS_DECLARE_DERIVED(erg,    dyne * centimeter)
+	UNITS_DECLARE_DERIVED(barye,  dyne / centimeter.pow<2>)
+	UNITS_DECLARE_DERIVED(poise,  barye * second)
+	UNITS_DECLARE_DERIVED(stokes, centimeter.pow<2> / second)
+	UNITS_DECLARE_DERIVED(gauss,  si::instances::tesla.scl<-4>)
+
+}
+
+namespace cgs_tests {
+	using namespace cgs::instances;
+
+	static_assert(dyne == si::instances::newton.scl<-5>, "");
+	static_assert(erg == si::instances::joule.scl<-7>, "");
+	static_assert(barye == si::instances::deci * si::instances::pascal, "");
+	constexpr auto work = unt::convert(2.0 * erg, si::instances::joule).value;
+	static_assert(work > 1.999999e-7 && work < 2.000001e-7, "");
+}
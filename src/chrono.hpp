@@ -0,0 +1,201 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+#include "units.hpp"
+#include "si.hpp"
+
+// Conversions between std::chrono::duration and quantities of (scaled) seconds.
+// A quantity of second::scale<S> behaves like duration<ValueType, 10^S>, so the
+// conversion is implicit exactly when chrono would convert implicitly (no
+// truncation) and explicit otherwise; integer values stay integers.
+namespace si {
+
+	namespace chrono_detail {
+
+		constexpr intmax_t pow10(intmax_t exponent) {
+			return exponent == 0 ? 1 : 10 * pow10(exponent - 1);
+		}
+
+		// Returns the base 10 logarithm of x, or 19 when x is not a power of ten.
+		constexpr intmax_t log10_exact(intmax_t x) {
+			return x == 1 ? 0 :
+				(x % 10 != 0 || x <= 0) ? 19 :
+				(log10_exact(x / 10) == 19 ? 19 : 1 + log10_exact(x / 10));
+		}
+
+		template<intmax_t Exp, typename = void>
+		struct period_of {
+			using type = std::ratio<pow10(Exp)>;
+		};
+
+		template<intmax_t Exp>
+		struct period_of<Exp, typename std::enable_if<(Exp < 0)>::type> {
+			using type = std::ratio<1, pow10(-Exp)>;
+		};
+
+		template<typename Period>
+		struct scale_of {
+			static constexpr bool exact =
+				(Period::den == 1 && log10_exact(Period::num) != 19) ||
+				(Period::num == 1 && log10_exact(Period::den) != 19);
+			static constexpr intmax_t value = Period::den == 1 ? log10_exact(Period::num) : -log10_exact(Period::den);
+		};
+
+		template<typename Unit>
+		struct is_chrono_compatible : std::false_type {};
+
+		template<intmax_t ScaleExpNum>
+		struct is_chrono_compatible<unt::unit<unt::dim_set<base_dim::second>, ScaleExpNum, 1>> :
+			std::integral_constant<bool, (ScaleExpNum >= -18 && ScaleExpNum <= 18)> {};
+
+		template<typename Unit, typename ValueType>
+		struct duration_of;
+
+		template<intmax_t ScaleExpNum, typename ValueType>
+		struct duration_of<unt::unit<unt::dim_set<base_dim::second>, ScaleExpNum, 1>, ValueType> {
+			using type = std::chrono::duration<ValueType, typename period_of<ScaleExpNum>::type>;
+		};
+
+	}
+
+	// The duration type a quantity corresponds to, e.g. milliseconds for
+	// quantity<decltype(milli * second)::type, long long>.
+	template<typename Quantity>
+	using duration_t = typename chrono_detail::duration_of<typename Quantity::unit_t, typename Quantity::value_t>::type;
+
+	template<typename Period>
+	using seconds_unit = units::second::scale<chrono_detail::scale_of<Period>::value>;
+
+	template<typename Rep, typename Period>
+	constexpr auto to_quantity(const std::chrono::duration<Rep, Period>& d) -> unt::quantity<seconds_unit<Period>, Rep> {
+		static_assert(chrono_detail::scale_of<Period>::exact, "Duration period is not a power of ten; convert to an explicit quantity type instead.");
+		return unt::quantity<seconds_unit<Period>, Rep>(d.count());
+	}
+
+	template<typename Unit, typename ValueType>
+	constexpr auto to_duration(const unt::quantity<Unit, ValueType>& q) -> duration_t<unt::quantity<Unit, ValueType>> {
+		static_assert(chrono_detail::is_chrono_compatible<Unit>::value, "Only quantities of seconds scaled by 10^-18 to 10^18 convert to durations.");
+		return duration_t<unt::quantity<Unit, ValueType>>(q.value);
+	}
+
+	template<typename Clock = std::chrono::steady_clock>
+	class stopwatch {
+	public:
+		using clock = Clock;
+		using quantity_t = decltype(to_quantity(std::declval<typename Clock::duration>()));
+
+		stopwatch() : start(Clock::now()) {};
+
+		quantity_t elapsed() const {
+			return to_quantity(Clock::now() - start);
+		}
+
+		void reset() {
+			start = Clock::now();
+		}
+
+	private:
+		typename Clock::time_point start;
+	};
+
+	// Calls callback(elapsed) with the typed elapsed time when the scope ends.
+	template<typename Callback, typename Clock = std::chrono::steady_clock>
+	class scoped_timer {
+	public:
+		using quantity_t = typename stopwatch<Clock>::quantity_t;
+
+		explicit scoped_timer(Callback callback) : callback(std::move(callback)), active(true) {};
+
+		scoped_timer(scoped_timer&& other) : callback(std::move(other.callback)), watch(other.watch), active(other.active) {
+			other.active = false;
+		}
+
+		scoped_timer(const scoped_timer&) = delete;
+		scoped_timer& operator=(const scoped_timer&) = delete;
+
+		~scoped_timer() {
+			if (active) {
+				callback(watch.elapsed());
+			}
+		}
+
+		quantity_t elapsed() const {
+			return watch.elapsed();
+		}
+
+	private:
+		Callback callback;
+		stopwatch<Clock> watch;
+		bool active;
+	};
+
+	template<typename Clock = std::chrono::steady_clock, typename Callback>
+	scoped_timer<Callback, Clock> make_scoped_timer(Callback callback) {
+		return scoped_timer<Callback, Clock>(std::move(callback));
+	}
+
+}
+
+namespace unt {
+
+	template<typename Rep, typename Period, typename Unit, typename ValueType>
+	struct quantity_conversion<std::chrono::duration<Rep, Period>, quantity<Unit, ValueType>,
+		typename std::enable_if<si::chrono_detail::is_chrono_compatible<Unit>::value>::type> {
+	private:
+		using from_t = std::chrono::duration<Rep, Period>;
+		using to_t = si::duration_t<quantity<Unit, ValueType>>;
+	public:
+		static constexpr bool exists = true;
+		static constexpr bool implicit = std::is_convertible<from_t, to_t>::value;
+
+		static constexpr ValueType convert(const from_t& d) {
+			return std::chrono::duration_cast<to_t>(d).count();
+		}
+	};
+
+	template<typename Unit, typename ValueType, typename Rep, typename Period>
+	struct quantity_conversion<quantity<Unit, ValueType>, std::chrono::duration<Rep, Period>,
+		typename std::enable_if<si::chrono_detail::is_chrono_compatible<Unit>::value>::type> {
+	private:
+		using from_t = si::duration_t<quantity<Unit, ValueType>>;
+		using to_t = std::chrono::duration<Rep, Period>;
+	public:
+		static constexpr bool exists = true;
+		static constexpr bool implicit = std::is_convertible<from_t, to_t>::value;
+
+		static constexpr to_t convert(const quantity<Unit, ValueType>& q) {
+			return std::chrono::duration_cast<to_t>(from_t(q.value));
+		}
+	};
+
+}
+
+namespace chrono_tests {
+	using namespace si::instances;
+	using ms_t = unt::quantity<decltype(milli * second)::type, long long>;
+	using us_t = unt::quantity<decltype(micro * second)::type, long long>;
+	using s_t = unt::quantity<si::units::second, double>;
+
+	static_assert(std::is_same<decltype(si::to_quantity(std::chrono::milliseconds(3))), unt::quantity<decltype(milli * second)::type, std::chrono::milliseconds::rep>>::value, "");
+	static_assert(si::to_quantity(std::chrono::nanoseconds(7)).value == 7, "");
+	static_assert(std::is_same<si::duration_t<ms_t>, std::chrono::duration<long long, std::milli>>::value, "");
+	static_assert(si::to_duration(ms_t(5)).count() == 5, "");
+
+	// Lossless directions are implicit, truncating ones explicit.
+	static_assert(std::is_convertible<std::chrono::milliseconds, us_t>::value, "");
+	static_assert(!std::is_convertible<std::chrono::microseconds, ms_t>::value, "");
+	static_assert(std::is_constructible<ms_t, std::chrono::microseconds>::value, "");
+	static_assert(std::is_convertible<std::chrono::nanoseconds, s_t>::value, "");
+	static_assert(std::is_convertible<ms_t, std::chrono::microseconds>::value, "");
+	static_assert(!std::is_convertible<s_t, std::chrono::milliseconds>::value, "");
+	static_assert(std::is_constructible<std::chrono::milliseconds, s_t>::value, "");
+
+	constexpr us_t from_minutes = std::chrono::minutes(2);
+	static_assert(from_minutes.value == 120000000, "");
+	static_assert(ms_t(std::chrono::microseconds(2500)).value == 2, "");
+	static_assert(static_cast<std::chrono::milliseconds>(s_t(1.5)).count() == 1500, "");
+}
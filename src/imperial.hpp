@@ -0,0 +1,32 @@
+#pragma once
+
+#include "units.hpp"
+#include "system.hpp"
+#include "si.hpp"
+
+// International yard and pound (1959). These are separate bases that convert to
+// SI through unt::convert, so foot * meter stays a mixed unit until converted.
+namespace imperial {
+
+	UNITS_DECLARE_SYSTEM(100)
+
+	UNITS_DECLARE_CONVERTIBLE_BASE(foot,  si::base::meter,    3048, 10000)
+	UNITS_DECLARE_CONVERTIBLE_BASE(inch,  base::foot,         1, 12)
+	UNITS_DECLARE_CONVERTIBLE_BASE(yard,  base::foot,         3, 1)
+	UNITS_DECLARE_CONVERTIBLE_BASE(mile,  base::foot,         5280, 1)
+	UNITS_DECLARE_CONVERTIBLE_BASE(pound, si::base::kilogram, 45359237, 100000000)
+	UNITS_DECLARE_CONVERTIBLE_BASE(ounce, base::pound,        1, 16)
+
+}
+
+namespace imperial_tests {
+	using namespace imperial::instances;
+	using test::near;
+
+	static_assert(near(unt::convert(3.0 * foot, si::instances::meter).value, 0.9144), "");
+	static_assert(near(unt::convert(1.0 * mile, si::instances::kilo * si::instances::meter).value, 1.609344), "");
+	static_assert(near(unt::convert(1.0 * inch.pow<3>, (si::instances::centi * si::instances::meter).pow<3>).value, 16.387064), "");
+	static_assert(near(unt::convert(16.0 * ounce, si::instances::gram).value, 453.59237), "");
+	static_assert(near(unt::convert(1.0 * foot * si::instances::meter, si::instances::meter.pow<2>).value, 0.3048), "");
+	static_assert(!unt::convertible<imperial::units::foot, si::units::kilogram>::value, "");
+}
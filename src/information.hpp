@@ -0,0 +1,24 @@
+#pragma once
+
+#include "units.hpp"
+#include "system.hpp"
+
+// Decimal SI prefixes apply as usual (kilo * byte is 1000 bytes). Binary
+// prefixes are not powers of ten and so are not provided.
+namespace information {
+
+	UNITS_DECLARE_SYSTEM(200)
+
+	UNITS_DECLARE_BASE(bit)
+	UNITS_DECLARE_CONVERTIBLE_BASE(nibble, base::bit, 4, 1)
+	UNITS_DECLARE_CONVERTIBLE_BASE(byte,   base::bit, 8, 1)
+
+}
+
+namespace information_tests {
+	using namespace information::instances;
+
+	static_assert(unt::convert(3 * byte, bit).value == 24.0, "");
+	static_assert(unt::convert(1.0 * bit, nibble).value == 0.25, "");
+	static_assert(unt::convertible<information::units::byte, information::units::bit>::value, "");
+}
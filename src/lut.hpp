@@ -0,0 +1,499 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#endif
+
+#include "units.hpp"
+#include "si.hpp"
+#include "math.hpp"
+
+// With fast FMA the compiler may contract y0 + t * (y1 - y0) on one path and not
+// another, so lerp fuses explicitly on every path to keep their results identical.
+#if defined(__FP_FAST_FMA) && defined(__FP_FAST_FMAF) && UNT_HAS_CONSTEXPR_MATH
+	#define UNT_LUT_FUSED_LERP 1
+#else
+	#define UNT_LUT_FUSED_LERP 0
+#endif
+
+// Lookup tables mapping quantity<XUnit, T> to quantity<YUnit, T>. Queries outside
+// the table clamp to its ends and NaN queries give a quiet NaN, on the scalar and
+// batched paths alike. Slopes are typed as YUnit::div<XUnit>.
+namespace unt {
+
+namespace grid {
+	// Samples at x0, x0 + step, x0 + 2 * step, ...
+	struct uniform {};
+	// Samples at strictly increasing breakpoints.
+	struct breakpoints {};
+}
+
+template<typename XUnit, typename YUnit, typename T, std::size_t N, typename Grid = grid::uniform>
+class lut;
+
+namespace lut_detail {
+
+template<typename T>
+struct segment {
+	std::size_t index;
+	T t;
+};
+
+template<typename T>
+constexpr bool is_nan(T x) {
+	return x != x;
+}
+
+template<typename T>
+constexpr T clamp(T x, T lo, T hi) {
+	return x < lo ? lo : (x > hi ? hi : x);
+}
+
+template<typename T>
+constexpr T lerp(T y0, T y1, T t) {
+#if UNT_LUT_FUSED_LERP
+	return math_detail::fma(t, y1 - y0, y0);
+#else
+	return y0 + t * (y1 - y0);
+#endif
+}
+
+// Cubic Hermite interpolation on [0, 1] with tangents already scaled to the segment width.
+template<typename T>
+constexpr T hermite(T y0, T y1, T m0, T m1, T t) {
+	return y0 + t * (m0 + t * ((3 * (y1 - y0) - 2 * m0 - m1) + t * (2 * (y0 - y1) + m0 + m1)));
+}
+
+template<typename T, std::size_t N>
+inline void uniform_linear_batch(T x0, T inv_step, const T (&y)[N], const T* xs, T* ys, std::size_t n, std::false_type) {
+	const T last = static_cast<T>(N - 1);
+	for (std::size_t i = 0; i < n; ++i) {
+		const T u = clamp((xs[i] - x0) * inv_step, T(0), last);
+		if (is_nan(u)) {
+			ys[i] = std::numeric_limits<T>::quiet_NaN();
+			continue;
+		}
+		const std::size_t index = static_cast<std::size_t>(u) < N - 2 ? static_cast<std::size_t>(u) : N - 2;
+		ys[i] = lerp(y[index], y[index + 1], u - static_cast<T>(index));
+	}
+}
+
+#if defined(__AVX2__)
+// Gathers both neighbours of eight (float) or four (double) queries per step. The
+// masked gathers with a zero source read the same lanes as the plain ones, but do
+// not leave GCC assuming an uninitialized source operand. max/min send NaN lanes
+// to index 0, and the final blend replaces them with a quiet NaN.
+inline __m256 lerp(__m256 y0, __m256 y1, __m256 t) {
+#if UNT_LUT_FUSED_LERP
+	return _mm256_fmadd_ps(t, _mm256_sub_ps(y1, y0), y0);
+#else
+	return _mm256_add_ps(y0, _mm256_mul_ps(t, _mm256_sub_ps(y1, y0)));
+#endif
+}
+
+inline __m256d lerp(__m256d y0, __m256d y1, __m256d t) {
+#if UNT_LUT_FUSED_LERP
+	return _mm256_fmadd_pd(t, _mm256_sub_pd(y1, y0), y0);
+#else
+	return _mm256_add_pd(y0, _mm256_mul_pd(t, _mm256_sub_pd(y1, y0)));
+#endif
+}
+
+template<std::size_t N>
+inline void uniform_linear_batch(float x0, float inv_step, const float (&y)[N], const float* xs, float* ys, std::size_t n, std::true_type) {
+	const __m256 origin = _mm256_set1_ps(x0);
+	const __m256 scale = _mm256_set1_ps(inv_step);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 last = _mm256_set1_ps(static_cast<float>(N - 1));
+	const __m256i last_index = _mm256_set1_epi32(static_cast<int>(N - 2));
+	const __m256 all_lanes = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+	const __m256 nan = _mm256_set1_ps(std::numeric_limits<float>::quiet_NaN());
+	std::size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		const __m256 x = _mm256_loadu_ps(xs + i);
+		const __m256 u = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(x, origin), scale), zero), last);
+		const __m256i index = _mm256_min_epi32(_mm256_cvttps_epi32(u), last_index);
+		const __m256 t = _mm256_sub_ps(u, _mm256_cvtepi32_ps(index));
+		const __m256 y0 = _mm256_mask_i32gather_ps(zero, y, index, all_lanes, 4);
+		const __m256 y1 = _mm256_mask_i32gather_ps(zero, y + 1, index, all_lanes, 4);
+		const __m256 result = lerp(y0, y1, t);
+		_mm256_storeu_ps(ys + i, _mm256_blendv_ps(result, nan, _mm256_cmp_ps(x, x, _CMP_UNORD_Q)));
+	}
+	uniform_linear_batch(x0, inv_step, y, xs + i, ys + i, n - i, std::false_type());
+}
+
+template<std::size_t N>
+inline void uniform_linear_batch(double x0, double inv_step, const double (&y)[N], const double* xs, double* ys, std::size_t n, std::true_type) {
+	const __m256d origin = _mm256_set1_pd(x0);
+	const __m256d scale = _mm256_set1_pd(inv_step);
+	const __m256d zero = _mm256_setzero_pd();
+	const __m256d last = _mm256_set1_pd(static_cast<double>(N - 1));
+	const __m128i last_index = _mm_set1_epi32(static_cast<int>(N - 2));
+	const __m256d all_lanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+	const __m256d nan = _mm256_set1_pd(std::numeric_limits<double>::quiet_NaN());
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const __m256d x = _mm256_loadu_pd(xs + i);
+		const __m256d u = _mm256_min_pd(_mm256_max_pd(_mm256_mul_pd(_mm256_sub_pd(x, origin), scale), zero), last);
+		const __m128i index = _mm_min_epi32(_mm256_cvttpd_epi32(u), last_index);
+		const __m256d t = _mm256_sub_pd(u, _mm256_cvtepi32_pd(index));
+		const __m256d y0 = _mm256_mask_i32gather_pd(zero, y, index, all_lanes, 8);
+		const __m256d y1 = _mm256_mask_i32gather_pd(zero, y + 1, index, all_lanes, 8);
+		const __m256d result = lerp(y0, y1, t);
+		_mm256_storeu_pd(ys + i, _mm256_blendv_pd(result, nan, _mm256_cmp_pd(x, x, _CMP_UNORD_Q)));
+	}
+	uniform_linear_batch(x0, inv_step, y, xs + i, ys + i, n - i, std::false_type());
+}
+#endif
+
+// Batched breakpoint kernels return how many queries they handled; the lut
+// finishes the rest with its scalar search.
+template<typename T, std::size_t N>
+inline std::size_t breakpoint_linear_batch(const T (&)[N], const T (&)[N], const T*, T*, std::size_t, std::false_type) {
+	return 0;
+}
+
+#if defined(__AVX2__)
+// Branchless form of lut::locate: every lane runs the same ceil(log2(N - 1))
+// probes, each a gather of x[lo + half] that advances lo where it is <= the
+// query. Each probe waits on the one before it, so the searches of
+// breakpoint_interleave vectors are run side by side to keep the gathers busy.
+// The segment ends are then gathered and interpolated as on the uniform grid.
+// min before max keeps a NaN t, as the scalar clamp does, and NaN queries are
+// blended to a quiet NaN.
+constexpr std::size_t breakpoint_interleave = 8;
+
+template<std::size_t N>
+inline std::size_t breakpoint_linear_batch(const float (&x)[N], const float (&y)[N], const float* xs, float* ys, std::size_t n, std::true_type) {
+	constexpr std::size_t k = breakpoint_interleave;
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 all_lanes = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+	const __m256 nan = _mm256_set1_ps(std::numeric_limits<float>::quiet_NaN());
+	std::size_t i = 0;
+	for (; i + 8 * k <= n; i += 8 * k) {
+		__m256 q[k];
+		__m256i lo[k];
+		for (std::size_t j = 0; j < k; ++j) {
+			q[j] = _mm256_loadu_ps(xs + i + 8 * j);
+			lo[j] = _mm256_setzero_si256();
+		}
+		for (std::size_t count = N - 1; count > 1; count -= count / 2) {
+			const __m256i half = _mm256_set1_epi32(static_cast<int>(count / 2));
+			for (std::size_t j = 0; j < k; ++j) {
+				const __m256 probe = _mm256_mask_i32gather_ps(zero, x, _mm256_add_epi32(lo[j], half), all_lanes, 4);
+				lo[j] = _mm256_add_epi32(lo[j], _mm256_and_si256(_mm256_castps_si256(_mm256_cmp_ps(probe, q[j], _CMP_LE_OQ)), half));
+			}
+		}
+		for (std::size_t j = 0; j < k; ++j) {
+			const __m256 x0 = _mm256_mask_i32gather_ps(zero, x, lo[j], all_lanes, 4);
+			const __m256 x1 = _mm256_mask_i32gather_ps(zero, x + 1, lo[j], all_lanes, 4);
+			const __m256 y0 = _mm256_mask_i32gather_ps(zero, y, lo[j], all_lanes, 4);
+			const __m256 y1 = _mm256_mask_i32gather_ps(zero, y + 1, lo[j], all_lanes, 4);
+			const __m256 t = _mm256_max_ps(zero, _mm256_min_ps(one, _mm256_div_ps(_mm256_sub_ps(q[j], x0), _mm256_sub_ps(x1, x0))));
+			_mm256_storeu_ps(ys + i + 8 * j, _mm256_blendv_ps(lerp(y0, y1, t), nan, _mm256_cmp_ps(q[j], q[j], _CMP_UNORD_Q)));
+		}
+	}
+	return i;
+}
+
+template<std::size_t N>
+inline std::size_t breakpoint_linear_batch(const double (&x)[N], const double (&y)[N], const double* xs, double* ys, std::size_t n, std::true_type) {
+	constexpr std::size_t k = breakpoint_interleave;
+	const __m256d zero = _mm256_setzero_pd();
+	const __m256d one = _mm256_set1_pd(1.0);
+	const __m256d all_lanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+	const __m256d nan = _mm256_set1_pd(std::numeric_limits<double>::quiet_NaN());
+	std::size_t i = 0;
+	for (; i + 4 * k <= n; i += 4 * k) {
+		__m256d q[k];
+		__m256i lo[k];
+		for (std::size_t j = 0; j < k; ++j) {
+			q[j] = _mm256_loadu_pd(xs + i + 4 * j);
+			lo[j] = _mm256_setzero_si256();
+		}
+		for (std::size_t count = N - 1; count > 1; count -= count / 2) {
+			const __m256i half = _mm256_set1_epi64x(static_cast<long long>(count / 2));
+			for (std::size_t j = 0; j < k; ++j) {
+				const __m256d probe = _mm256_mask_i64gather_pd(zero, x, _mm256_add_epi64(lo[j], half), all_lanes, 8);
+				lo[j] = _mm256_add_epi64(lo[j], _mm256_and_si256(_mm256_castpd_si256(_mm256_cmp_pd(probe, q[j], _CMP_LE_OQ)), half));
+			}
+		}
+		for (std::size_t j = 0; j < k; ++j) {
+			const __m256d x0 = _mm256_mask_i64gather_pd(zero, x, lo[j], all_lanes, 8);
+			const __m256d x1 = _mm256_mask_i64gather_pd(zero, x + 1, lo[j], all_lanes, 8);
+			const __m256d y0 = _mm256_mask_i64gather_pd(zero, y, lo[j], all_lanes, 8);
+			const __m256d y1 = _mm256_mask_i64gather_pd(zero, y + 1, lo[j], all_lanes, 8);
+			const __m256d t = _mm256_max_pd(zero, _mm256_min_pd(one, _mm256_div_pd(_mm256_sub_pd(q[j], x0), _mm256_sub_pd(x1, x0))));
+			_mm256_storeu_pd(ys + i + 4 * j, _mm256_blendv_pd(lerp(y0, y1, t), nan, _mm256_cmp_pd(q[j], q[j], _CMP_UNORD_Q)));
+		}
+	}
+	return i;
+}
+#endif
+
+template<typename T, std::size_t N>
+using has_gather = std::integral_constant<bool,
+#if defined(__AVX2__)
+	(std::is_same<T, float>::value || std::is_same<T, double>::value) && N <= 0x7FFFFFFF
+#else
+	false
+#endif
+>;
+
+}
+
+template<typename XUnit, typename YUnit, typename T, std::size_t N>
+class lut<XUnit, YUnit, T, N, grid::uniform> {
+	static_assert(N >= 2, "A lookup table needs at least two samples.");
+	static_assert(std::is_floating_point<T>::value, "Lookup tables interpolate and need a floating point value type.");
+public:
+	using x_t = quantity<XUnit, T>;
+	using y_t = quantity<YUnit, T>;
+	using slope_t = quantity<typename YUnit::template div<XUnit>, T>;
+
+	constexpr lut(const x_t& x0, const x_t& step, const T (&y)[N]) :
+		lut(x0, step, y, std::make_index_sequence<N>()) {};
+
+	static constexpr std::size_t size() {
+		return N;
+	}
+
+	constexpr x_t x_min() const {
+		return x_t(x0);
+	}
+
+	constexpr x_t x_max() const {
+		return x_t(x0 + step * static_cast<T>(N - 1));
+	}
+
+	constexpr y_t operator()(const x_t& x) const {
+		return y_t(linear_at(locate(x.value)));
+	}
+
+	constexpr slope_t slope(const x_t& x) const {
+		return slope_t(slope_at(locate(x.value)));
+	}
+
+	// Catmull-Rom spline through the samples, with one-sided tangents at the ends.
+	constexpr y_t cubic(const x_t& x) const {
+		return y_t(cubic_at(locate(x.value)));
+	}
+
+	// Linear interpolation of n quantities into ys, which receives the values in
+	// YUnit (quantity is not assignable, so the output is raw). Uses AVX2 gathers
+	// for float and double when available.
+	void operator()(const x_t* xs, T* ys, std::size_t n) const {
+		operator()(values_of(xs), ys, n);
+	}
+
+	// As above, for xs already holding values in XUnit.
+	void operator()(const T* xs, T* ys, std::size_t n) const {
+		lut_detail::uniform_linear_batch(x0, inv_step, y, xs, ys, n, lut_detail::has_gather<T, N>());
+	}
+
+private:
+	T x0;
+	T step;
+	T inv_step;
+	T y[N];
+
+	template<std::size_t... Is>
+	constexpr lut(const x_t& x0, const x_t& step, const T (&y)[N], std::index_sequence<Is...>) :
+		x0(x0.value), step(step.value), inv_step(T(1) / step.value), y{y[Is]...}
+	{
+		if (!(step.value > T(0))) {
+			throw std::invalid_argument("Lookup table step must be positive");
+		}
+	}
+
+	constexpr lut_detail::segment<T> locate(T x) const {
+		return segment_at(lut_detail::clamp((x - x0) * inv_step, T(0), static_cast<T>(N - 1)));
+	}
+
+	// A NaN position never reaches the cast; it becomes segment 0 with t = NaN,
+	// which every interpolation below carries through to a NaN result.
+	static constexpr lut_detail::segment<T> segment_at(T u) {
+		return lut_detail::is_nan(u) ? lut_detail::segment<T>{0, std::numeric_limits<T>::quiet_NaN()} : lut_detail::segment<T>{
+			static_cast<std::size_t>(u) < N - 2 ? static_cast<std::size_t>(u) : N - 2,
+			u - static_cast<T>(static_cast<std::size_t>(u) < N - 2 ? static_cast<std::size_t>(u) : N - 2)
+		};
+	}
+
+	constexpr T linear_at(lut_detail::segment<T> s) const {
+		return lut_detail::lerp(y[s.index], y[s.index + 1], s.t);
+	}
+
+	constexpr T slope_at(lut_detail::segment<T> s) const {
+		return lut_detail::is_nan(s.t) ? s.t : (y[s.index + 1] - y[s.index]) * inv_step;
+	}
+
+	constexpr T tangent(std::size_t i) const {
+		return i == 0 ? y[1] - y[0] :
+			i == N - 1 ? y[N - 1] - y[N - 2] :
+			(y[i + 1] - y[i - 1]) / 2;
+	}
+
+	constexpr T cubic_at(lut_detail::segment<T> s) const {
+		return lut_detail::hermite(y[s.index], y[s.index + 1], tangent(s.index), tangent(s.index + 1), s.t);
+	}
+};
+
+template<typename XUnit, typename YUnit, typename T, std::size_t N>
+class lut<XUnit, YUnit, T, N, grid::breakpoints> {
+	static_assert(N >= 2, "A lookup table needs at least two samples.");
+	static_assert(std::is_floating_point<T>::value, "Lookup tables interpolate and need a floating point value type.");
+public:
+	using x_t = quantity<XUnit, T>;
+	using y_t = quantity<YUnit, T>;
+	using slope_t = quantity<typename YUnit::template div<XUnit>, T>;
+
+	constexpr lut(const T (&x)[N], const T (&y)[N]) :
+		lut(x, y, std::make_index_sequence<N>()) {};
+
+	static constexpr std::size_t size() {
+		return N;
+	}
+
+	constexpr x_t x_min() const {
+		return x_t(x[0]);
+	}
+
+	constexpr x_t x_max() const {
+		return x_t(x[N - 1]);
+	}
+
+	constexpr y_t operator()(const x_t& query) const {
+		return y_t(linear_at(locate(query.value), query.value));
+	}
+
+	constexpr slope_t slope(const x_t& query) const {
+		return slope_t(lut_detail::is_nan(query.value) ? std::numeric_limits<T>::quiet_NaN() : slope_at(locate(query.value)));
+	}
+
+	// Cubic Hermite spline with finite-difference tangents, the non-uniform
+	// counterpart of the uniform grid's Catmull-Rom spline.
+	constexpr y_t cubic(const x_t& query) const {
+		return y_t(cubic_at(locate(query.value), query.value));
+	}
+
+	// Linear interpolation of n quantities into ys, which receives the values in
+	// YUnit. Uses a branchless AVX2 gather search when available; the remainder,
+	// and every query without AVX2, takes the scalar binary search.
+	void operator()(const x_t* xs, T* ys, std::size_t n) const {
+		operator()(values_of(xs), ys, n);
+	}
+
+	// As above, for xs already holding values in XUnit.
+	void operator()(const T* xs, T* ys, std::size_t n) const {
+		for (std::size_t i = lut_detail::breakpoint_linear_batch(x, y, xs, ys, n, lut_detail::has_gather<T, N>()); i < n; ++i) {
+			ys[i] = linear_at(locate(xs[i]), xs[i]);
+		}
+	}
+
+private:
+	T x[N];
+	T y[N];
+
+	template<std::size_t... Is>
+	constexpr lut(const T (&x)[N], const T (&y)[N], std::index_sequence<Is...>) :
+		x{x[Is]...}, y{y[Is]...}
+	{
+		for (std::size_t i = 0; i + 1 < N; ++i) {
+			if (!(x[i] < x[i + 1])) {
+				throw std::invalid_argument("Lookup table breakpoints must be strictly increasing");
+			}
+		}
+	}
+
+	// Index of the segment [x[i], x[i + 1]] holding the query, by binary search.
+	constexpr std::size_t locate(T query) const {
+		std::size_t lo = 0;
+		std::size_t count = N - 1;
+		while (count > 1) {
+			const std::size_t half = count / 2;
+			lo = x[lo + half] <= query ? lo + half : lo;
+			count -= half;
+		}
+		return lo;
+	}
+
+	constexpr T clamped_t(std::size_t i, T query) const {
+		return lut_detail::is_nan(query) ? std::numeric_limits<T>::quiet_NaN() : lut_detail::clamp((query - x[i]) / (x[i + 1] - x[i]), T(0), T(1));
+	}
+
+	constexpr T linear_at(std::size_t i, T query) const {
+		return lut_detail::lerp(y[i], y[i + 1], clamped_t(i, query));
+	}
+
+	constexpr T slope_at(std::size_t i) const {
+		return (y[i + 1] - y[i]) / (x[i + 1] - x[i]);
+	}
+
+	constexpr T tangent(std::size_t i) const {
+		return i == 0 ? (y[1] - y[0]) / (x[1] - x[0]) :
+			i == N - 1 ? (y[N - 1] - y[N - 2]) / (x[N - 1] - x[N - 2]) :
+			(y[i + 1] - y[i - 1]) / (x[i + 1] - x[i - 1]);
+	}
+
+	constexpr T cubic_at(std::size_t i, T query) const {
+		return lut_detail::hermite(y[i], y[i + 1], tangent(i) * (x[i + 1] - x[i]), tangent(i + 1) * (x[i + 1] - x[i]), clamped_t(i, query));
+	}
+};
+
+// Both factories take the units in the order of lut itself, <XUnit, YUnit>.
+template<typename XUnit, typename YUnit, typename T, std::size_t N>
+constexpr lut<XUnit, YUnit, T, N, grid::uniform> make_uniform_lut(const quantity<XUnit, T>& x0, const quantity<XUnit, T>& step, const T (&y)[N]) {
+	return lut<XUnit, YUnit, T, N, grid::uniform>(x0, step, y);
+}
+
+template<typename XUnit, typename YUnit, typename T, std::size_t N>
+constexpr lut<XUnit, YUnit, T, N, grid::breakpoints> make_breakpoint_lut(const T (&x)[N], const T (&y)[N]) {
+	return lut<XUnit, YUnit, T, N, grid::breakpoints>(x, y);
+}
+
+}
+
+namespace lut_tests {
+	using namespace unt;
+
+	using m = si::units::meter;
+	using s = si::units::second;
+
+	constexpr double squares[] = {0.0, 1.0, 4.0, 9.0, 16.0};
+	constexpr auto uniform = make_uniform_lut<m, s>(quantity<m, double>(0.0), quantity<m, double>(1.0), squares);
+
+	static_assert(uniform(quantity<m, double>(2.5)).value == 6.5, "");
+	static_assert(uniform(quantity<m, double>(-1.0)).value == 0.0, "");
+	static_assert(uniform(quantity<m, double>(9.0)).value == 16.0, "");
+	static_assert(uniform.cubic(quantity<m, double>(2.0)).value == 4.0, "");
+	static_assert(uniform.cubic(quantity<m, double>(2.5)).value == 6.25, "");
+	static_assert(std::is_same<decltype(uniform.slope(quantity<m, double>(2.5))), quantity<s::div<m>, double>>::value, "");
+	static_assert(uniform.slope(quantity<m, double>(2.5)).value == 5.0, "");
+	static_assert(uniform.x_max().value == 4.0, "");
+
+	constexpr double xs[] = {0.0, 1.0, 3.0, 7.0};
+	constexpr double ys[] = {10.0, 20.0, 30.0, 70.0};
+	constexpr auto breakpoints = make_breakpoint_lut<m, s>(xs, ys);
+
+	static_assert(breakpoints(quantity<m, double>(2.0)).value == 25.0, "");
+	static_assert(breakpoints(quantity<m, double>(5.0)).value == 50.0, "");
+	static_assert(breakpoints(quantity<m, double>(100.0)).value == 70.0, "");
+	static_assert(breakpoints.slope(quantity<m, double>(4.0)).value == 10.0, "");
+	static_assert(breakpoints.cubic(quantity<m, double>(3.0)).value == 30.0, "");
+
+	// NaN queries give NaN on every path instead of a clamped sample.
+	constexpr quantity<m, double> nan_query = std::numeric_limits<double>::quiet_NaN();
+	static_assert(lut_detail::is_nan(uniform(nan_query).value), "");
+	static_assert(lut_detail::is_nan(uniform.cubic(nan_query).value), "");
+	static_assert(lut_detail::is_nan(uniform.slope(nan_query).value), "");
+	static_assert(lut_detail::is_nan(breakpoints(nan_query).value), "");
+	static_assert(lut_detail::is_nan(breakpoints.cubic(nan_query).value), "");
+	static_assert(lut_detail::is_nan(breakpoints.slope(nan_query).value), "");
+}
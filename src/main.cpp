@@ -1,6 +1,15 @@
 #include <iostream>
 #include <units.hpp>
 #include <si.hpp>
+#include <math.hpp>
+#include <system.hpp>
+#include <imperial.hpp>
+#include <cgs.hpp>
+#include <information.hpp>
+#include <si_literals.hpp>
+#include <storage.hpp>
+#include <chrono.hpp>
+#include <lut.hpp>
 
 /**
  * Operations:
@@ -0,0 +1,226 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+#include <gcem.hpp>
+
+#include "units.hpp"
+#include "si.hpp"
+
+// Selects gcem during constant evaluation and the <cmath> routines (which
+// lower to hardware instructions such as sqrtsd) at runtime. Without compiler
+// support the functions always use <cmath> and are not constexpr.
+#if defined(__cpp_lib_is_constant_evaluated)
+	#define UNT_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__GNUC__) && __GNUC__ >= 9
+	#define UNT_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#elif defined(__has_builtin)
+	#if __has_builtin(__builtin_is_constant_evaluated)
+		#define UNT_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+	#endif
+#endif
+
+#ifdef UNT_IS_CONSTANT_EVALUATED
+	#define UNT_HAS_CONSTEXPR_MATH 1
+	#define UNT_MATH_CONSTEXPR constexpr
+#else
+	#define UNT_HAS_CONSTEXPR_MATH 0
+	#define UNT_MATH_CONSTEXPR
+	#define UNT_IS_CONSTANT_EVALUATED() false
+#endif
+
+namespace unt {
+
+namespace math_detail {
+
+template<typename T>
+using real_t = decltype(std::sqrt(std::declval<T>()));
+
+template<typename T>
+UNT_MATH_CONSTEXPR real_t<T> sqrt(T x) {
+	return UNT_IS_CONSTANT_EVALUATED() ? static_cast<real_t<T>>(gcem::sqrt(x)) : std::sqrt(x);
+}
+
+template<typename T>
+UNT_MATH_CONSTEXPR real_t<T> cbrt(T x) {
+	return UNT_IS_CONSTANT_EVALUATED() ?
+		(x < 0 ? -static_cast<real_t<T>>(gcem::pow(-x, 1.0 / 3.0)) : static_cast<real_t<T>>(gcem::pow(x, 1.0 / 3.0))) :
+		std::cbrt(x);
+}
+
+template<typename T>
+UNT_MATH_CONSTEXPR real_t<T> pow(T x, real_t<T> exponent) {
+	return UNT_IS_CONSTANT_EVALUATED() ? static_cast<real_t<T>>(gcem::pow(x, exponent)) : std::pow(x, exponent);
+}
+
+template<typename T>
+UNT_MATH_CONSTEXPR real_t<T> exp(T x) {
+	return UNT_IS_CONSTANT_EVALUATED() ? static_cast<real_t<T>>(gcem::exp(x)) : std::exp(x);
+}
+
+template<typename T>
+UNT_MATH_CONSTEXPR real_t<T> log(T x) {
+	return UNT_IS_CONSTANT_EVALUATED() ? static_cast<real_t<T>>(gcem::log(x)) : std::log(x);
+}
+
+template<typename T>
+UNT_MATH_CONSTEXPR T abs(T x) {
+	return UNT_IS_CONSTANT_EVALUATED() ? static_cast<T>(gcem::abs(x)) : static_cast<T>(std::abs(x));
+}
+
+template<typename T>
+UNT_MATH_CONSTEXPR real_t<T> hypot(T x, T y) {
+	return UNT_IS_CONSTANT_EVALUATED() ? static_cast<real_t<T>>(gcem::sqrt(x * x + y * y)) : std::hypot(x, y);
+}
+
+template<typename T>
+UNT_MATH_CONSTEXPR T fma(T x, T y, T z) {
+	return UNT_IS_CONSTANT_EVALUATED() ? x * y + z : static_cast<T>(std::fma(x, y, z));
+}
+
+// Exponentiation by squaring, exact for integer value types.
+template<typename T>
+constexpr T ipow(T x, intmax_t exponent) {
+	return exponent == 0 ? T(1) :
+		exponent % 2 == 0 ? ipow(x * x, exponent / 2) :
+		x * ipow(x * x, exponent / 2);
+}
+
+template<intmax_t Num, intmax_t Den, typename = void>
+struct pow_impl {
+	template<typename T>
+	static UNT_MATH_CONSTEXPR real_t<T> apply(T x) {
+		return math_detail::pow(x, static_cast<real_t<T>>(Num) / static_cast<real_t<T>>(Den));
+	}
+};
+
+template<intmax_t Num>
+struct pow_impl<Num, 1, typename std::enable_if<(Num >= 0)>::type> {
+	template<typename T>
+	static constexpr T apply(T x) {
+		return ipow(x, Num);
+	}
+};
+
+template<intmax_t Num>
+struct pow_impl<Num, 1, typename std::enable_if<(Num < 0)>::type> {
+	template<typename T>
+	static constexpr real_t<T> apply(T x) {
+		return real_t<T>(1) / ipow(static_cast<real_t<T>>(x), -Num);
+	}
+};
+
+template<intmax_t Num>
+struct pow_impl<Num, 2> {
+	template<typename T>
+	static UNT_MATH_CONSTEXPR real_t<T> apply(T x) {
+		return math_detail::sqrt(pow_impl<Num, 1>::apply(static_cast<real_t<T>>(x)));
+	}
+};
+
+template<intmax_t Num>
+struct pow_impl<Num, 3> {
+	template<typename T>
+	static UNT_MATH_CONSTEXPR real_t<T> apply(T x) {
+		return math_detail::cbrt(pow_impl<Num, 1>::apply(static_cast<real_t<T>>(x)));
+	}
+};
+
+template<intmax_t Num, intmax_t Den>
+using reduced_pow_impl = pow_impl<std::ratio<Num, Den>::num, std::ratio<Num, Den>::den>;
+
+template<typename Unit>
+struct is_dimensionless : std::is_same<typename Unit::dims, dim_set<>> {};
+
+}
+
+template<typename Unit, typename ValueType>
+UNT_MATH_CONSTEXPR auto sqrt(const quantity<Unit, ValueType>& q) -> quantity<typename Unit::template power<1, 2>, math_detail::real_t<ValueType>> {
+	return quantity<typename Unit::template power<1, 2>, math_detail::real_t<ValueType>>(math_detail::sqrt(q.value));
+}
+
+template<typename Unit, typename ValueType>
+UNT_MATH_CONSTEXPR auto cbrt(const quantity<Unit, ValueType>& q) -> quantity<typename Unit::template power<1, 3>, math_detail::real_t<ValueType>> {
+	return quantity<typename Unit::template power<1, 3>, math_detail::real_t<ValueType>>(math_detail::cbrt(q.value));
+}
+
+template<intmax_t Num, intmax_t Den = 1, typename Unit, typename ValueType>
+constexpr auto pow(const quantity<Unit, ValueType>& q) -> quantity<typename Unit::template power<Num, Den>, decltype(math_detail::reduced_pow_impl<Num, Den>::apply(q.value))> {
+	return quantity<typename Unit::template power<Num, Den>, decltype(math_detail::reduced_pow_impl<Num, Den>::apply(q.value))>(math_detail::reduced_pow_impl<Num, Den>::apply(q.value));
+}
+
+template<typename Unit, typename ValueType>
+UNT_MATH_CONSTEXPR auto abs(const quantity<Unit, ValueType>& q) -> quantity<Unit, ValueType> {
+	return quantity<Unit, ValueType>(math_detail::abs(q.value));
+}
+
+template<typename Unit, typename ValueType, typename RHSUnit, typename RHSValueType>
+UNT_MATH_CONSTEXPR auto hypot(const quantity<Unit, ValueType>& lhs, const quantity<RHSUnit, RHSValueType>& rhs) -> quantity<Unit, math_detail::real_t<typename std::common_type<ValueType, RHSValueType>::type>> {
+	static_assert(Unit::template equal<RHSUnit>::value == true, "Cannot take hypot of different units.");
+	using value_t = typename std::common_type<ValueType, RHSValueType>::type;
+	return quantity<Unit, math_detail::real_t<value_t>>(math_detail::hypot(static_cast<value_t>(lhs.value), static_cast<value_t>(rhs.value)));
+}
+
+template<typename UnitA, typename ValueTypeA, typename UnitB, typename ValueTypeB, typename UnitC, typename ValueTypeC>
+UNT_MATH_CONSTEXPR auto fma(const quantity<UnitA, ValueTypeA>& a, const quantity<UnitB, ValueTypeB>& b, const quantity<UnitC, ValueTypeC>& c) -> quantity<UnitC, typename std::common_type<ValueTypeA, ValueTypeB, ValueTypeC>::type> {
+	static_assert(UnitA::template mul<UnitB>::template equal<UnitC>::value == true, "Cannot add different units together.");
+	using value_t = typename std::common_type<ValueTypeA, ValueTypeB, ValueTypeC>::type;
+	return quantity<UnitC, value_t>(math_detail::fma(static_cast<value_t>(a.value), static_cast<value_t>(b.value), static_cast<value_t>(c.value)));
+}
+
+template<typename Unit, typename ValueType>
+UNT_MATH_CONSTEXPR auto exp(const quantity<Unit, ValueType>& q) -> quantity<unit<dim_set<>>, math_detail::real_t<ValueType>> {
+	static_assert(math_detail::is_dimensionless<Unit>::value, "exp requires a dimensionless quantity.");
+	return quantity<unit<dim_set<>>, math_detail::real_t<ValueType>>(math_detail::exp(q.value * Unit::scale_factor));
+}
+
+template<typename Unit, typename ValueType>
+UNT_MATH_CONSTEXPR auto log(const quantity<Unit, ValueType>& q) -> quantity<unit<dim_set<>>, math_detail::real_t<ValueType>> {
+	static_assert(math_detail::is_dimensionless<Unit>::value, "log requires a dimensionless quantity.");
+	return quantity<unit<dim_set<>>, math_detail::real_t<ValueType>>(math_detail::log(q.value * Unit::scale_factor));
+}
+
+}
+
+namespace math_tests {
+	using namespace unt;
+	using namespace si::instances;
+	using test::near;
+
+	using m = si::units::meter;
+	using s = si::units::second;
+
+	constexpr quantity<m::power<2>, double> area = 9.0;
+	static_assert(std::is_same<decltype(unt::sqrt(area))::unit_t, m>::value, "");
+
+	constexpr quantity<m::power<3>, double> volume = -27.0;
+	static_assert(std::is_same<decltype(unt::cbrt(volume))::unit_t, m>::value, "");
+
+	constexpr quantity<m, int> side = 3;
+	static_assert(std::is_same<decltype(unt::pow<2>(side)), quantity<m::power<2>, int>>::value, "");
+	static_assert(unt::pow<2>(side).value == 9, "");
+	static_assert(std::is_same<decltype(unt::pow<0>(side)), quantity<si::units::dimensionless, int>>::value, "");
+	static_assert(unt::pow<0>(side).value == 1, "");
+	static_assert(std::is_same<decltype(unt::pow<-1>(side))::unit_t, m::power<-1>>::value, "");
+	static_assert(std::is_same<decltype(unt::pow<3, 2>(area))::unit_t, m::power<3>>::value, "");
+	static_assert(std::is_same<decltype(unt::pow<2, 4>(area)), decltype(unt::sqrt(area))>::value, "");
+
+	constexpr quantity<m, double> a = 3.0;
+	constexpr quantity<m, double> b = -4.0;
+	constexpr quantity<s, double> t = 2.0;
+	constexpr quantity<m::div<s>, double> v = 1.5;
+	constexpr auto fifty_percent = 50.0 * centi;
+
+#if UNT_HAS_CONSTEXPR_MATH
+	static_assert(near(unt::sqrt(area).value, 3.0), "");
+	static_assert(near(unt::cbrt(volume).value, -3.0), "");
+	static_assert(near(unt::pow<3, 2>(area).value, 27.0), "");
+	static_assert(near(unt::hypot(a, b).value, 5.0), "");
+	static_assert(unt::abs(b).value == 4.0, "");
+	static_assert(unt::fma(v, t, a).value == 6.0, "");
+	static_assert(near(unt::log(unt::exp(fifty_percent)).value, 0.5), "");
+#endif
+}
@@ -0,0 +1,82 @@
+#include <type_traits>
+
+#include "units.hpp"
+#include "si.hpp"
+
+// Compiles every SI quantity in full once, so a unit that cannot be instantiated
+// fails here rather than in the first consumer that touches it. The library also
+// carries the precompiled headers and the unt.si module.
+
+// Units with a distinct type, i.e. the derived list minus aliases such as
+// radian (dimensionless), lumen (candela) and sievert (gray).
+#define UNITS_SI_DISTINCT(X) \
+X(meter) \
+X(kilogram) \
+X(second) \
+X(ampere) \
+X(kelvin) \
+X(mole) \
+X(candela) \
+X(dimensionless) \
+X(hertz) \
+X(newton) \
+X(pascal) \
+X(joule) \
+X(watt) \
+X(coulomb) \
+X(volt) \
+X(farad) \
+X(ohm) \
+X(siemen) \
+X(weber) \
+X(tesla) \
+X(henry) \
+X(lux) \
+X(gray) \
+X(katal) \
+X(bar) \
+X(gram)
+
+namespace si {
+
+	namespace distinct_detail {
+
+		template<typename T, typename... Units>
+		constexpr int count_same() {
+			const bool same[] = {false, std::is_same<T, Units>::value...};
+			int count = 0;
+			for (bool s : same) {
+				count += s;
+			}
+			return count;
+		}
+
+		#define UNITS_SI_DISTINCT_TYPE(name) , si::units::name
+
+		template<typename T>
+		constexpr int distinct_matches() {
+			return count_same<T UNITS_SI_DISTINCT(UNITS_SI_DISTINCT_TYPE)>();
+		}
+
+		#undef UNITS_SI_DISTINCT_TYPE
+
+	}
+
+}
+
+// Every base and derived unit must have exactly one entry in UNITS_SI_DISTINCT:
+// none means it is never instantiated, two mean a duplicate instantiation.
+#define UNITS_SI_CHECK_DISTINCT(name, ...) \
+static_assert(si::distinct_detail::distinct_matches<si::units::name>() == 1, "si::units::" #name " must match exactly one UNITS_SI_DISTINCT entry");
+
+UNITS_SI_BASES(UNITS_SI_CHECK_DISTINCT)
+UNITS_SI_DERIVED(UNITS_SI_CHECK_DISTINCT)
+UNITS_SI_DISTINCT(UNITS_SI_CHECK_DISTINCT)
+
+#undef UNITS_SI_CHECK_DISTINCT
+
+#define UNITS_SI_INSTANTIATE_QUANTITY(name) \
+template struct unt::quantity<si::units::name, double>; \
+template struct unt::quantity<si::units::name, float>;
+
+UNITS_SI_DISTINCT(UNITS_SI_INSTANTIATE_QUANTITY)
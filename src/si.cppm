@@ -0,0 +1,67 @@
+module;
+
+#include "units.hpp"
+#include "si.hpp"
+#include "si_literals.hpp"
+
+export module unt.si;
+
+// Untested: no compiler available so far has built and imported this module.
+// g++ 12 loses the re-exported using-declarations in nested namespaces, so
+// importers cannot see si::instances, si::literals or si::parse.
+
+export namespace unt {
+	using unt::dim;
+	using unt::is_dim;
+	using unt::dim_cmp;
+	using unt::dim_set;
+	using unt::is_dim_set;
+	using unt::dim_set_pow;
+	using unt::dim_set_mul;
+	using unt::unit;
+	using unt::is_unit;
+	using unt::enforce_unit;
+	using unt::quantity;
+	using unt::is_quantity;
+	using unt::enforce_quantity;
+	using unt::is_undimensioned;
+	using unt::enforce_undimensioned;
+	using unt::operator*;
+	using unt::operator/;
+	using unt::conversion;
+	using unt::convertible;
+	using unt::convert;
+}
+
+#define UNITS_SI_EXPORT_BASE(name, order) \
+export namespace si { \
+	namespace base { using si::base::name; } \
+	namespace base_dim { using si::base_dim::name; } \
+}
+
+#define UNITS_SI_EXPORT_UNIT(name, ...) \
+export namespace si { \
+	namespace units { using si::units::name; } \
+	namespace instances { using si::instances::name; } \
+}
+
+UNITS_SI_BASES(UNITS_SI_EXPORT_BASE)
+UNITS_SI_BASES(UNITS_SI_EXPORT_UNIT)
+UNITS_SI_PREFIXES(UNITS_SI_EXPORT_UNIT)
+UNITS_SI_DERIVED(UNITS_SI_EXPORT_UNIT)
+
+#define UNITS_SI_EXPORT_LITERAL(suffix, ...) \
+export namespace si { \
+	namespace literals { using si::literals::operator"" ## suffix; } \
+}
+
+UNITS_SI_LITERALS(UNITS_SI_EXPORT_LITERAL)
+
+// UNT_UNIT is a macro and cannot be exported. Module users include
+// si_unit_macro.hpp, which expands to these names.
+export namespace si {
+	namespace parse {
+		using si::parse::char_at;
+		using si::parse::unit_of;
+	}
+}
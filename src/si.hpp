@@ -1,101 +1,80 @@
 #pragma once
 
-#include "si.hpp"
+#include "units.hpp"
+#include "system.hpp"
 
 namespace si {
 
-	#define UNITS_SI_DECLARE_BASE(name, order) \
-	namespace base { \
-		struct name { \
-			static constexpr intmax_t sort_order = (order); \
-		}; \
-	} \
-	namespace base_dim { \
-		using name = unt::dim<base::name>; \
-	} \
-	namespace units { \
-		using name = unt::unit<unt::dim_set<unt::dim<base::name>>>; \
-	} \
-	namespace instances { \
-		constexpr auto name = units::name::instance(); \
-	}
+	#define UNITS_SI_DECLARE_BASE(name, order) UNITS_DECLARE_ORDERED_BASE(name, order)
 
 	namespace units {
 		using dimensionless = unt::unit<unt::dim_set<>>;
 	}
 
-
-
-	#define UNITS_SI_DECLARE_PREFIX(name, base_10_power) \
-	namespace units { \
-		using name = unt::unit<unt::dim_set<>, base_10_power>; \
-	} \
-	namespace instances { \
-		constexpr auto name = units::name::instance(); \
-	}
-
-	#define UNITS_SI_DECLARE_DERIVED(name, unit_expression) \
-	namespace instances { \
-		constexpr auto name = decltype(unit_expression)::instance(); \
-	} \
-	namespace units { \
-		using name = decltype(instances::name)::type; \
-	}
-
-
-	UNITS_SI_DECLARE_BASE(meter,    0);
-	UNITS_SI_DECLARE_BASE(kilogram, 1);
-	UNITS_SI_DECLARE_BASE(second,   2);
-	UNITS_SI_DECLARE_BASE(ampere,   3);
-	UNITS_SI_DECLARE_BASE(kelvin,   4);
-	UNITS_SI_DECLARE_BASE(mole,     5);
-	UNITS_SI_DECLARE_BASE(candela,  6);
-
-	UNITS_SI_DECLARE_PREFIX(yotta,  24);
-	UNITS_SI_DECLARE_PREFIX(zetta,  21);
-	UNITS_SI_DECLARE_PREFIX(exa,    18);
-	UNITS_SI_DECLARE_PREFIX(peta,   15);
-	UNITS_SI_DECLARE_PREFIX(tera,   12);
-	UNITS_SI_DECLARE_PREFIX(giga,    9);
-	UNITS_SI_DECLARE_PREFIX(mega,    6);
-	UNITS_SI_DECLARE_PREFIX(kilo,    3);
-	UNITS_SI_DECLARE_PREFIX(hecto,   2);
-	UNITS_SI_DECLARE_PREFIX(deka,    1);
-	UNITS_SI_DECLARE_PREFIX(dimensionless, 0);
-	UNITS_SI_DECLARE_PREFIX(deci,   -1);
-	UNITS_SI_DECLARE_PREFIX(centi,  -2);
-	UNITS_SI_DECLARE_PREFIX(milli,  -3);
-	UNITS_SI_DECLARE_PREFIX(micro,  -6);
-	UNITS_SI_DECLARE_PREFIX(nano,   -9);
-	UNITS_SI_DECLARE_PREFIX(pico,  -12);
-	UNITS_SI_DECLARE_PREFIX(femto, -15);
-	UNITS_SI_DECLARE_PREFIX(atto,  -18);
-	UNITS_SI_DECLARE_PREFIX(zepto, -21);
-	UNITS_SI_DECLARE_PREFIX(yocto, -24);
-
-	UNITS_SI_DECLARE_DERIVED(radian,    meter / meter);
-	UNITS_SI_DECLARE_DERIVED(steradian, meter.pow<2> / meter.pow<2>)
-	UNITS_SI_DECLARE_DERIVED(hertz,     second.pow<-1>);
-	UNITS_SI_DECLARE_DERIVED(newton,    kilogram * meter / second.pow<2>);
-	UNITS_SI_DECLARE_DERIVED(pascal,    newton / meter.pow<2>);
-	UNITS_SI_DECLARE_DERIVED(joule,     newton * meter);
-	UNITS_SI_DECLARE_DERIVED(watt,      joule / second);
-	UNITS_SI_DECLARE_DERIVED(coulomb,   ampere * second);
-	UNITS_SI_DECLARE_DERIVED(volt,      joule / coulomb);
-	UNITS_SI_DECLARE_DERIVED(farad,     coulomb / volt);
-	UNITS_SI_DECLARE_DERIVED(ohm,       volt / ampere);
-	UNITS_SI_DECLARE_DERIVED(siemen,    dimensionless / ohm);
-	UNITS_SI_DECLARE_DERIVED(weber,     joule / ampere);
-	UNITS_SI_DECLARE_DERIVED(tesla,     volt * second / meter.pow<2>);
-	UNITS_SI_DECLARE_DERIVED(henry,     volt * second / ampere);
-	UNITS_SI_DECLARE_DERIVED(lumen,     candela * steradian);
-	UNITS_SI_DECLARE_DERIVED(lux,       lumen / meter.pow<2>);
-	UNITS_SI_DECLARE_DERIVED(gray,      joule / kilogram);
-	UNITS_SI_DECLARE_DERIVED(sievert,   joule / kilogram);
-	UNITS_SI_DECLARE_DERIVED(katal,     mole / second);
-
-	UNITS_SI_DECLARE_DERIVED(bar,   hecto * kilo * pascal);
-	UNITS_SI_DECLARE_DERIVED(gram,  milli * kilogram);
+	#define UNITS_SI_DECLARE_PREFIX(name, base_10_power) UNITS_DECLARE_PREFIX(name, base_10_power)
+
+	#define UNITS_SI_DECLARE_DERIVED(name, unit_expression) UNITS_DECLARE_DERIVED(name, unit_expression)
+
+
+	#define UNITS_SI_BASES(X) \
+	X(meter,    0) \
+	X(kilogram, 1) \
+	X(second,   2) \
+	X(ampere,   3) \
+	X(kelvin,   4) \
+	X(mole,     5) \
+	X(candela,  6)
+
+	#define UNITS_SI_PREFIXES(X) \
+	X(yotta,  24) \
+	X(zetta,  21) \
+	X(exa,    18) \
+	X(peta,   15) \
+	X(tera,   12) \
+	X(giga,    9) \
+	X(mega,    6) \
+	X(kilo,    3) \
+	X(hecto,   2) \
+	X(deka,    1) \
+	X(dimensionless, 0) \
+	X(deci,   -1) \
+	X(centi,  -2) \
+	X(milli,  -3) \
+	X(micro,  -6) \
+	X(nano,   -9) \
+	X(pico,  -12) \
+	X(femto, -15) \
+	X(atto,  -18) \
+	X(zepto, -21) \
+	X(yocto, -24)
+
+	#define UNITS_SI_DERIVED(X) \
+	X(radian,    meter / meter) \
+	X(steradian, meter.pow<2> / meter.pow<2>) \
+	X(hertz,     second.pow<-1>) \
+	X(newton,    kilogram * meter / second.pow<2>) \
+	X(pascal,    newton / meter.pow<2>) \
+	X(joule,     newton * meter) \
+	X(watt,      joule / second) \
+	X(coulomb,   ampere * second) \
+	X(volt,      joule / coulomb) \
+	X(farad,     coulomb / volt) \
+	X(ohm,       volt / ampere) \
+	X(siemen,    dimensionless / ohm) \
+	X(weber,     joule / ampere) \
+	X(tesla,     volt * second / meter.pow<2>) \
+	X(henry,     volt * second / ampere) \
+	X(lumen,     candela * steradian) \
+	X(lux,       lumen / meter.pow<2>) \
+	X(gray,      joule / kilogram) \
+	X(sievert,   joule / kilogram) \
+	X(katal,     mole / second) \
+	X(bar,       hecto * kilo * pascal) \
+	X(gram,      milli * kilogram)
+
+	UNITS_SI_BASES(UNITS_SI_DECLARE_BASE)
+	UNITS_SI_PREFIXES(UNITS_SI_DECLARE_PREFIX)
+	UNITS_SI_DERIVED(UNITS_SI_DECLARE_DERIVED)
 
 }
 
@@ -104,6 +83,12 @@ namespace test {
 	using namespace si;
 	using namespace si::instances;
 
+	// Relative comparison for results that went through floating-point arithmetic.
+	constexpr bool near(double a, double b) {
+		const double tolerance = 1e-9 * (b < -1.0 ? -b : (b > 1.0 ? b : 1.0));
+		return a - b <= tolerance && b - a <= tolerance;
+	}
+
 	//Test dimension comparison
 	static_assert(unt::dim_cmp<base_dim::kilogram, base_dim::meter>::lt == false, "");
 	static_assert(unt::dim_cmp<base_dim::kilogram, base_dim::meter>::le == false, "");
@@ -121,6 +106,13 @@ namespace test {
 
 	static_assert(kilogram == kilo * gram, "");
 
+	//Test unit algebra
+	static_assert(meter * meter == meter.pow<2>, "");
+	static_assert(meter / meter == dimensionless, "");
+	static_assert(std::is_same<units::pascal::dims, unt::dim_set<base_dim::meter::pow<-1>, base_dim::kilogram, base_dim::second::pow<-2>>>::value, "");
+	static_assert(std::is_same<units::sievert, units::gray>::value, "");
+	static_assert(std::is_same<units::lumen, units::candela>::value, "");
+
 
 	using namespace si::instances;
 	constexpr unt::quantity<units::meter, double> displacement = 0.5;
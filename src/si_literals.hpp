@@ -0,0 +1,397 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "units.hpp"
+#include "si.hpp"
+#include "si_unit_macro.hpp"
+
+namespace si {
+
+	#define UNITS_SI_LITERALS(X) \
+	X(_m,    instances::meter) \
+	X(_km,   instances::kilo * instances::meter) \
+	X(_cm,   instances::centi * instances::meter) \
+	X(_mm,   instances::milli * instances::meter) \
+	X(_um,   instances::micro * instances::meter) \
+	X(_nm,   instances::nano * instances::meter) \
+	X(_s,    instances::second) \
+	X(_ms,   instances::milli * instances::second) \
+	X(_us,   instances::micro * instances::second) \
+	X(_ns,   instances::nano * instances::second) \
+	X(_kg,   instances::kilogram) \
+	X(_g,    instances::gram) \
+	X(_mg,   instances::milli * instances::gram) \
+	X(_A,    instances::ampere) \
+	X(_mA,   instances::milli * instances::ampere) \
+	X(_K,    instances::kelvin) \
+	X(_mol,  instances::mole) \
+	X(_cd,   instances::candela) \
+	X(_rad,  instances::radian) \
+	X(_Hz,   instances::hertz) \
+	X(_kHz,  instances::kilo * instances::hertz) \
+	X(_MHz,  instances::mega * instances::hertz) \
+	X(_GHz,  instances::giga * instances::hertz) \
+	X(_N,    instances::newton) \
+	X(_kN,   instances::kilo * instances::newton) \
+	X(_Pa,   instances::pascal) \
+	X(_kPa,  instances::kilo * instances::pascal) \
+	X(_MPa,  instances::mega * instances::pascal) \
+	X(_bar,  instances::bar) \
+	X(_J,    instances::joule) \
+	X(_kJ,   instances::kilo * instances::joule) \
+	X(_W,    instances::watt) \
+	X(_kW,   instances::kilo * instances::watt) \
+	X(_MW,   instances::mega * instances::watt) \
+	X(_C,    instances::coulomb) \
+	X(_V,    instances::volt) \
+	X(_mV,   instances::milli * instances::volt) \
+	X(_kV,   instances::kilo * instances::volt) \
+	X(_F,    instances::farad) \
+	X(_uF,   instances::micro * instances::farad) \
+	X(_nF,   instances::nano * instances::farad) \
+	X(_pF,   instances::pico * instances::farad) \
+	X(_ohm,  instances::ohm) \
+	X(_kohm, instances::kilo * instances::ohm) \
+	X(_S,    instances::siemen) \
+	X(_Wb,   instances::weber) \
+	X(_T,    instances::tesla) \
+	X(_H,    instances::henry) \
+	X(_lm,   instances::lumen) \
+	X(_lx,   instances::lux) \
+	X(_Gy,   instances::gray) \
+	X(_Sv,   instances::sievert) \
+	X(_kat,  instances::katal)
+
+	// Floating literals give double quantities, integer literals keep an integer value type.
+	#define UNITS_SI_DECLARE_LITERAL(suffix, unit_expression) \
+	constexpr unt::quantity<decltype(unit_expression)::type, double> operator"" ## suffix(long double value) { \
+		return unt::quantity<decltype(unit_expression)::type, double>(static_cast<double>(value)); \
+	} \
+	constexpr unt::quantity<decltype(unit_expression)::type, long long> operator"" ## suffix(unsigned long long value) { \
+		return unt::quantity<decltype(unit_expression)::type, long long>(static_cast<long long>(value)); \
+	}
+
+	namespace literals {
+		UNITS_SI_LITERALS(UNITS_SI_DECLARE_LITERAL)
+	}
+
+	// Symbols understood by UNT_UNIT. A token matching a symbol exactly wins over a
+	// prefixed reading, so "m" is meter, "Pa" is pascal and "mm" is milli meter.
+	#define UNITS_SI_SYMBOLS(X) \
+	X("m",   meter) \
+	X("kg",  kilogram) \
+	X("g",   gram) \
+	X("s",   second) \
+	X("A",   ampere) \
+	X("K",   kelvin) \
+	X("mol", mole) \
+	X("cd",  candela) \
+	X("rad", radian) \
+	X("sr",  steradian) \
+	X("Hz",  hertz) \
+	X("N",   newton) \
+	X("Pa",  pascal) \
+	X("J",   joule) \
+	X("W",   watt) \
+	X("C",   coulomb) \
+	X("V",   volt) \
+	X("F",   farad) \
+	X("ohm", ohm) \
+	X("S",   siemen) \
+	X("Wb",  weber) \
+	X("T",   tesla) \
+	X("H",   henry) \
+	X("lm",  lumen) \
+	X("lx",  lux) \
+	X("Gy",  gray) \
+	X("Sv",  sievert) \
+	X("kat", katal) \
+	X("bar", bar)
+
+	// "da" comes before "d" so the longer prefix is tried first.
+	#define UNITS_SI_PREFIX_SYMBOLS(X) \
+	X("Y",   24) \
+	X("Z",   21) \
+	X("E",   18) \
+	X("P",   15) \
+	X("T",   12) \
+	X("G",    9) \
+	X("M",    6) \
+	X("k",    3) \
+	X("h",    2) \
+	X("da",   1) \
+	X("d",   -1) \
+	X("c",   -2) \
+	X("m",   -3) \
+	X("u",   -6) \
+	X("n",   -9) \
+	X("p",  -12) \
+	X("f",  -15) \
+	X("a",  -18) \
+	X("z",  -21) \
+	X("y",  -24)
+
+	namespace parse {
+
+		#define UNITS_SI_SYMBOL_NAME(symbol, name) symbol,
+		#define UNITS_SI_SYMBOL_UNIT(symbol, name) units::name,
+		#define UNITS_SI_PREFIX_ENTRY(symbol, base_10_power) prefix_entry{symbol, base_10_power},
+
+		struct prefix_entry {
+			const char* symbol;
+			intmax_t base_10_power;
+		};
+
+		constexpr const char* symbol_names[] = { UNITS_SI_SYMBOLS(UNITS_SI_SYMBOL_NAME) };
+		constexpr prefix_entry prefixes[] = { UNITS_SI_PREFIX_SYMBOLS(UNITS_SI_PREFIX_ENTRY) };
+		using symbol_units = std::tuple<UNITS_SI_SYMBOLS(UNITS_SI_SYMBOL_UNIT) void>;
+
+		constexpr std::size_t symbol_count = sizeof(symbol_names) / sizeof(symbol_names[0]);
+		constexpr std::size_t prefix_count = sizeof(prefixes) / sizeof(prefixes[0]);
+		constexpr std::size_t max_length = 64;
+		constexpr std::size_t max_terms = 16;
+
+		struct term {
+			std::size_t symbol = 0;
+			intmax_t base_10_power = 0;
+			intmax_t exp_num = 1;
+			intmax_t exp_den = 1;
+		};
+
+		struct result {
+			std::size_t count = 0;
+			term terms[max_terms] = {};
+		};
+
+		template<std::size_t N>
+		constexpr char char_at(const char (&str)[N], std::size_t i) {
+			return i < N ? str[i] : '\0';
+		}
+
+		constexpr bool is_letter(char c) {
+			return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+		}
+
+		constexpr bool is_digit(char c) {
+			return c >= '0' && c <= '9';
+		}
+
+		// Compares str[begin, end) with a null terminated symbol.
+		constexpr bool token_equals(const char* str, std::size_t begin, std::size_t end, const char* symbol) {
+			std::size_t i = 0;
+			for (; begin + i < end; ++i) {
+				if (symbol[i] != str[begin + i]) {
+					return false;
+				}
+			}
+			return symbol[i] == '\0';
+		}
+
+		constexpr std::size_t symbol_length(const char* symbol) {
+			std::size_t i = 0;
+			while (symbol[i] != '\0') {
+				++i;
+			}
+			return i;
+		}
+
+		constexpr std::size_t find_symbol(const char* str, std::size_t begin, std::size_t end) {
+			for (std::size_t i = 0; i < symbol_count; ++i) {
+				if (token_equals(str, begin, end, symbol_names[i])) {
+					return i;
+				}
+			}
+			return symbol_count;
+		}
+
+		// "kg" already carries a prefix and SI does not stack them, so prefixed
+		// masses are read from "g" only.
+		constexpr bool accepts_prefix(std::size_t symbol) {
+			return !token_equals("kg", 0, 2, symbol_names[symbol]);
+		}
+
+		constexpr term resolve(const char* str, std::size_t begin, std::size_t end) {
+			term t;
+			t.symbol = find_symbol(str, begin, end);
+			if (t.symbol != symbol_count) {
+				return t;
+			}
+			for (std::size_t i = 0; i < prefix_count; ++i) {
+				const std::size_t length = symbol_length(prefixes[i].symbol);
+				if (begin + length < end && token_equals(str, begin, begin + length, prefixes[i].symbol)) {
+					t.symbol = find_symbol(str, begin + length, end);
+					if (t.symbol != symbol_count && accepts_prefix(t.symbol)) {
+						t.base_10_power = prefixes[i].base_10_power;
+						return t;
+					}
+				}
+			}
+			throw std::invalid_argument("Unknown unit symbol");
+		}
+
+		constexpr intmax_t parse_int(const char* str, std::size_t& pos) {
+			bool negative = false;
+			if (str[pos] == '-' || str[pos] == '+') {
+				negative = str[pos] == '-';
+				++pos;
+			}
+			if (!is_digit(str[pos])) {
+				throw std::invalid_argument("Expected an integer exponent");
+			}
+			intmax_t value = 0;
+			while (is_digit(str[pos])) {
+				value = value * 10 + (str[pos] - '0');
+				++pos;
+			}
+			return negative ? -value : value;
+		}
+
+		constexpr void skip_spaces(const char* str, std::size_t& pos) {
+			while (str[pos] == ' ') {
+				++pos;
+			}
+		}
+
+		// Grammar: term (('*' | '.' | '/') term)*, where term is a symbol with an optional
+		// prefix or the number 1, optionally followed by ^int, ^(int) or ^(int/int).
+		constexpr result parse_string(const char* str) {
+			result r;
+			std::size_t pos = 0;
+			intmax_t sign = 1;
+			skip_spaces(str, pos);
+			while (true) {
+				term t;
+				bool dimensionless = false;
+				if (str[pos] == '1' && !is_digit(str[pos + 1])) {
+					dimensionless = true;
+					++pos;
+				}
+				else {
+					const std::size_t begin = pos;
+					while (is_letter(str[pos])) {
+						++pos;
+					}
+					if (begin == pos) {
+						throw std::invalid_argument("Expected a unit symbol");
+					}
+					t = resolve(str, begin, pos);
+				}
+				if (str[pos] == '^') {
+					++pos;
+					const bool parenthesized = str[pos] == '(';
+					if (parenthesized) {
+						++pos;
+					}
+					t.exp_num = parse_int(str, pos);
+					if (parenthesized && str[pos] == '/') {
+						++pos;
+						t.exp_den = parse_int(str, pos);
+						if (t.exp_den == 0) {
+							throw std::invalid_argument("Zero exponent denominator");
+						}
+					}
+					if (parenthesized) {
+						if (str[pos] != ')') {
+							throw std::invalid_argument("Expected ')'");
+						}
+						++pos;
+					}
+				}
+				t.exp_num *= sign;
+				if (!dimensionless) {
+					if (r.count == max_terms) {
+						throw std::invalid_argument("Too many terms in unit expression");
+					}
+					r.terms[r.count] = t;
+					++r.count;
+				}
+				skip_spaces(str, pos);
+				if (str[pos] == '\0') {
+					return r;
+				}
+				else if (str[pos] == '*' || str[pos] == '.') {
+					sign = 1;
+				}
+				else if (str[pos] == '/') {
+					sign = -1;
+				}
+				else {
+					throw std::invalid_argument("Unexpected character in unit expression");
+				}
+				++pos;
+				skip_spaces(str, pos);
+			}
+		}
+
+		template<char... Chars>
+		constexpr result parse_chars() {
+			constexpr char str[] = {Chars..., '\0'};
+			return parse_string(str);
+		}
+
+		template<typename... Units>
+		struct product;
+
+		template<>
+		struct product<> {
+			using type = unt::unit<unt::dim_set<>>;
+		};
+
+		template<typename Unit0, typename... Units>
+		struct product<Unit0, Units...> {
+			using type = typename Unit0::template mul<typename product<Units...>::type>;
+		};
+
+		template<typename Indices, char... Chars>
+		struct unit_of_helper;
+
+		template<std::size_t... Is, char... Chars>
+		struct unit_of_helper<std::index_sequence<Is...>, Chars...> {
+			static constexpr result parsed = parse_chars<Chars...>();
+
+			template<std::size_t I>
+			using term_unit = typename std::tuple_element<parsed.terms[I].symbol, symbol_units>::type
+				::template scale<parsed.terms[I].base_10_power>
+				::template power<parsed.terms[I].exp_num, parsed.terms[I].exp_den>;
+
+			using type = typename product<term_unit<Is>...>::type;
+		};
+
+		template<std::size_t Length, char... Chars>
+		struct unit_of {
+			static_assert(Length <= max_length, "Unit expression too long for UNT_UNIT");
+			using type = typename unit_of_helper<std::make_index_sequence<parse_chars<Chars...>().count>, Chars...>::type;
+		};
+
+	}
+
+}
+
+namespace si_literals_tests {
+	using namespace si::literals;
+	using namespace si::instances;
+
+	static_assert(std::is_same<decltype(10.0_m), unt::quantity<si::units::meter, double>>::value, "");
+	static_assert(std::is_same<decltype(5_kPa), unt::quantity<decltype(kilo * pascal), long long>>::value, "");
+	static_assert((3_ms).value == 3, "");
+	static_assert(std::is_same<decltype(2.0_m / 4.0_s)::unit_t, decltype(meter / second)>::value, "");
+
+	static_assert(std::is_same<UNT_UNIT("kg*m/s^2"), si::units::newton>::value, "");
+	static_assert(std::is_same<UNT_UNIT("N/m^2"), si::units::pascal>::value, "");
+	static_assert(std::is_same<UNT_UNIT("kPa"), decltype(kilo * pascal)>::value, "");
+	static_assert(std::is_same<UNT_UNIT("mm"), decltype(milli * meter)>::value, "");
+	static_assert(std::is_same<UNT_UNIT("km^2"), decltype((kilo * meter).pow<2>)::type>::value, "");
+	static_assert(std::is_same<UNT_UNIT("1/s"), si::units::hertz>::value, "");
+	static_assert(std::is_same<UNT_UNIT("m.s^-1"), decltype(meter / second)>::value, "");
+	static_assert(std::is_same<UNT_UNIT("m^(1/2)"), decltype(meter.pow<1, 2>)::type>::value, "");
+	static_assert(std::is_same<UNT_UNIT(" J / kg "), si::units::gray>::value, "");
+	static_assert(std::is_same<UNT_UNIT("1"), si::units::dimensionless>::value, "");
+	static_assert(std::is_same<UNT_UNIT("cd"), si::units::candela>::value, "");
+	static_assert(std::is_same<UNT_UNIT("mol/s"), si::units::katal>::value, "");
+	static_assert(std::is_same<UNT_UNIT("mg"), decltype(milli * gram)>::value, "");
+	static_assert(std::is_same<UNT_UNIT("kg"), si::units::kilogram>::value, "");
+}
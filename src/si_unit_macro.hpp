@@ -0,0 +1,19 @@
+#pragma once
+
+// UNT_UNIT and the macros it expands to. si_literals.hpp includes this; users of
+// the unt.si module, which cannot export macros, include it next to the import.
+
+#define UNITS_SI_CHARS_8(str, i) \
+::si::parse::char_at(str, (i) + 0), ::si::parse::char_at(str, (i) + 1), \
+::si::parse::char_at(str, (i) + 2), ::si::parse::char_at(str, (i) + 3), \
+::si::parse::char_at(str, (i) + 4), ::si::parse::char_at(str, (i) + 5), \
+::si::parse::char_at(str, (i) + 6), ::si::parse::char_at(str, (i) + 7)
+
+#define UNITS_SI_CHARS_64(str) \
+UNITS_SI_CHARS_8(str,  0), UNITS_SI_CHARS_8(str,  8), UNITS_SI_CHARS_8(str, 16), UNITS_SI_CHARS_8(str, 24), \
+UNITS_SI_CHARS_8(str, 32), UNITS_SI_CHARS_8(str, 40), UNITS_SI_CHARS_8(str, 48), UNITS_SI_CHARS_8(str, 56)
+
+// Resolves a unit expression such as "kg*m/s^2" to its canonical unt::unit type
+// during compilation. The result is the same type the unit algebra produces, so
+// `using accel = UNT_UNIT("m/s^2");` is an ordinary alias.
+#define UNT_UNIT(str) typename ::si::parse::unit_of<sizeof(str), UNITS_SI_CHARS_64(str)>::type
@@ -0,0 +1,439 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__F16C__)
+	#include <immintrin.h>
+#endif
+
+#include "units.hpp"
+#include "si.hpp"
+
+// Storage-only value types for quantity. They hold fewer bytes per value and
+// convert implicitly to float (or double), so arithmetic on quantity<U, half>
+// yields quantity<U, float> through the usual decltype(value + rhs.value).
+namespace unt {
+
+namespace storage_detail {
+
+inline std::uint32_t float_bits(float x) {
+	std::uint32_t bits;
+	std::memcpy(&bits, &x, sizeof(bits));
+	return bits;
+}
+
+inline float bits_float(std::uint32_t bits) {
+	float x;
+	std::memcpy(&x, &bits, sizeof(x));
+	return x;
+}
+
+// IEEE 754 binary32 to binary16, round to nearest even.
+inline std::uint16_t float_to_half(float x) {
+#if defined(__F16C__)
+	return static_cast<std::uint16_t>(_cvtss_sh(x, _MM_FROUND_TO_NEAREST_INT));
+#else
+	const std::uint32_t bits = float_bits(x);
+	const std::uint16_t sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+	const std::uint32_t abs_bits = bits & 0x7FFFFFFFu;
+	if (abs_bits >= 0x7F800000u) {
+		// Inf stays inf, NaN stays a quiet NaN.
+		return static_cast<std::uint16_t>(sign | 0x7C00u | (abs_bits > 0x7F800000u ? 0x0200u | ((abs_bits >> 13) & 0x03FFu) : 0u));
+	}
+	if (abs_bits >= 0x477FF000u) {
+		// Rounds to a magnitude of at least 65520, which overflows to inf.
+		return static_cast<std::uint16_t>(sign | 0x7C00u);
+	}
+	if (abs_bits < 0x38800000u) {
+		// Subnormal half or zero: align the implicit bit, then round.
+		if (abs_bits < 0x33000000u) {
+			return sign;
+		}
+		const std::uint32_t exponent = abs_bits >> 23;
+		const std::uint32_t mantissa = (abs_bits & 0x007FFFFFu) | 0x00800000u;
+		const std::uint32_t shift = 126u - exponent;
+		const std::uint32_t half_mantissa = mantissa >> shift;
+		const std::uint32_t remainder = mantissa & ((1u << shift) - 1u);
+		const std::uint32_t halfway = 1u << (shift - 1u);
+		const std::uint32_t round_up = (remainder > halfway || (remainder == halfway && (half_mantissa & 1u))) ? 1u : 0u;
+		return static_cast<std::uint16_t>(sign | (half_mantissa + round_up));
+	}
+	const std::uint32_t rebased = abs_bits - 0x38000000u;
+	const std::uint32_t round_up = 0x0FFFu + ((rebased >> 13) & 1u);
+	return static_cast<std::uint16_t>(sign | ((rebased + round_up) >> 13));
+#endif
+}
+
+inline float half_to_float(std::uint16_t h) {
+#if defined(__F16C__)
+	return _cvtsh_ss(h);
+#else
+	const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+	const std::uint32_t exponent = (h >> 10) & 0x1Fu;
+	std::uint32_t mantissa = h & 0x03FFu;
+	if (exponent == 0x1Fu) {
+		// Inf stays inf; NaN comes out quiet, as vcvtph2ps produces it.
+		return bits_float(sign | 0x7F800000u | (mantissa << 13) | (mantissa != 0 ? 0x00400000u : 0u));
+	}
+	if (exponent != 0) {
+		return bits_float(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+	}
+	if (mantissa == 0) {
+		return bits_float(sign);
+	}
+	// Subnormal half: normalize into a float exponent.
+	std::uint32_t float_exponent = 113u;
+	while ((mantissa & 0x0400u) == 0) {
+		mantissa <<= 1;
+		--float_exponent;
+	}
+	return bits_float(sign | (float_exponent << 23) | ((mantissa & 0x03FFu) << 13));
+#endif
+}
+
+// Truncates binary32 to its top 16 bits, round to nearest even.
+inline std::uint16_t float_to_bfloat16(float x) {
+	const std::uint32_t bits = float_bits(x);
+	if ((bits & 0x7FFFFFFFu) > 0x7F800000u) {
+		return static_cast<std::uint16_t>((bits >> 16) | 0x0040u);
+	}
+	return static_cast<std::uint16_t>((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+}
+
+inline float bfloat16_to_float(std::uint16_t b) {
+	return bits_float(static_cast<std::uint32_t>(b) << 16);
+}
+
+}
+
+struct half {
+	std::uint16_t bits;
+
+	half() = default;
+
+	half(float value) : bits(storage_detail::float_to_half(value)) {};
+
+	static half from_bits(std::uint16_t bits) {
+		half h;
+		h.bits = bits;
+		return h;
+	}
+
+	operator float() const {
+		return storage_detail::half_to_float(bits);
+	}
+};
+
+struct bfloat16 {
+	std::uint16_t bits;
+
+	bfloat16() = default;
+
+	bfloat16(float value) : bits(storage_detail::float_to_bfloat16(value)) {};
+
+	static bfloat16 from_bits(std::uint16_t bits) {
+		bfloat16 b;
+		b.bits = bits;
+		return b;
+	}
+
+	operator float() const {
+		return storage_detail::bfloat16_to_float(bits);
+	}
+};
+
+// Linear quantization: value = raw * Resolution + Offset, both in the unit of the
+// quantity holding it. Out of range values saturate to the ends of Int and NaN
+// stores the lowest raw value.
+template<typename Int, typename Resolution, typename Offset = std::ratio<0>>
+struct quantized {
+	static_assert(std::is_integral<Int>::value, "quantized requires an integer storage type.");
+	static_assert(Resolution::num > 0, "quantized resolution must be positive.");
+
+	using raw_t = Int;
+	using widened_t = typename std::conditional<(sizeof(Int) <= 2), float, double>::type;
+
+	static constexpr widened_t resolution = static_cast<widened_t>(Resolution::num) / static_cast<widened_t>(Resolution::den);
+	static constexpr widened_t inverse_resolution = static_cast<widened_t>(Resolution::den) / static_cast<widened_t>(Resolution::num);
+	static constexpr widened_t offset = static_cast<widened_t>(Offset::num) / static_cast<widened_t>(Offset::den);
+	static constexpr widened_t min = static_cast<widened_t>(std::numeric_limits<Int>::min()) * resolution + offset;
+	static constexpr widened_t max = static_cast<widened_t>(std::numeric_limits<Int>::max()) * resolution + offset;
+
+	Int raw;
+
+	quantized() = default;
+
+	quantized(widened_t value) : raw(quantize(value)) {};
+
+	static constexpr quantized from_raw(Int raw) {
+		return quantized(raw, 0);
+	}
+
+	constexpr operator widened_t() const {
+		return static_cast<widened_t>(raw) * resolution + offset;
+	}
+
+	static Int quantize(widened_t value) {
+		if (std::isnan(value)) {
+			return std::numeric_limits<Int>::min();
+		}
+		const widened_t scaled = std::nearbyint((value - offset) * inverse_resolution);
+		return scaled <= static_cast<widened_t>(std::numeric_limits<Int>::min()) ? std::numeric_limits<Int>::min() :
+			scaled >= static_cast<widened_t>(std::numeric_limits<Int>::max()) ? std::numeric_limits<Int>::max() :
+			static_cast<Int>(scaled);
+	}
+
+private:
+	constexpr quantized(Int raw, int) : raw(raw) {};
+};
+
+template<typename Int, typename Resolution, typename Offset>
+constexpr typename quantized<Int, Resolution, Offset>::widened_t quantized<Int, Resolution, Offset>::resolution;
+
+template<typename Int, typename Resolution, typename Offset>
+constexpr typename quantized<Int, Resolution, Offset>::widened_t quantized<Int, Resolution, Offset>::inverse_resolution;
+
+template<typename Int, typename Resolution, typename Offset>
+constexpr typename quantized<Int, Resolution, Offset>::widened_t quantized<Int, Resolution, Offset>::offset;
+
+template<typename Int, typename Resolution, typename Offset>
+constexpr typename quantized<Int, Resolution, Offset>::widened_t quantized<Int, Resolution, Offset>::min;
+
+template<typename Int, typename Resolution, typename Offset>
+constexpr typename quantized<Int, Resolution, Offset>::widened_t quantized<Int, Resolution, Offset>::max;
+
+template<typename T>
+struct widened {
+	using type = T;
+};
+
+template<>
+struct widened<half> {
+	using type = float;
+};
+
+template<>
+struct widened<bfloat16> {
+	using type = float;
+};
+
+template<typename Int, typename Resolution, typename Offset>
+struct widened<quantized<Int, Resolution, Offset>> {
+	using type = typename quantized<Int, Resolution, Offset>::widened_t;
+};
+
+template<typename T>
+using widened_t = typename widened<T>::type;
+
+template<typename Unit, typename ValueType>
+constexpr auto widen(const quantity<Unit, ValueType>& q) -> quantity<Unit, widened_t<ValueType>> {
+	return quantity<Unit, widened_t<ValueType>>(static_cast<widened_t<ValueType>>(q.value));
+}
+
+// Bulk conversion kernels over contiguous values. Each takes either raw values or
+// an array of quantities (read through values_of); the output is raw because
+// quantity is not assignable.
+
+inline void pack(const float* in, half* out, std::size_t n) {
+	std::size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+	for (; i + 8 <= n; i += 8) {
+		const __m128i packed = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+	}
+#endif
+	for (; i < n; ++i) {
+		out[i] = half(in[i]);
+	}
+}
+
+inline void unpack(const half* in, float* out, std::size_t n) {
+	std::size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+	for (; i + 8 <= n; i += 8) {
+		const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+		_mm256_storeu_ps(out + i, _mm256_cvtph_ps(packed));
+	}
+#endif
+	for (; i < n; ++i) {
+		out[i] = in[i];
+	}
+}
+
+inline void pack(const float* in, bfloat16* out, std::size_t n) {
+	std::size_t i = 0;
+#if defined(__AVX2__)
+	const __m256i rounding_bias = _mm256_set1_epi32(0x7FFF);
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i quiet_bit = _mm256_set1_epi32(0x0040);
+	for (; i + 16 <= n; i += 16) {
+		__m256i results[2];
+		for (int half_block = 0; half_block < 2; ++half_block) {
+			const __m256 values = _mm256_loadu_ps(in + i + 8 * half_block);
+			const __m256i bits = _mm256_castps_si256(values);
+			const __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+			const __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(bits, rounding_bias), lsb), 16);
+			const __m256i nan = _mm256_or_si256(_mm256_srli_epi32(bits, 16), quiet_bit);
+			const __m256i is_nan = _mm256_castps_si256(_mm256_cmp_ps(values, values, _CMP_UNORD_Q));
+			results[half_block] = _mm256_blendv_epi8(rounded, nan, is_nan);
+		}
+		// packus works per 128-bit lane, so restore element order afterwards.
+		const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(results[0], results[1]), 0xD8);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+	}
+#endif
+	for (; i < n; ++i) {
+		out[i] = bfloat16(in[i]);
+	}
+}
+
+inline void unpack(const bfloat16* in, float* out, std::size_t n) {
+	std::size_t i = 0;
+#if defined(__AVX2__)
+	for (; i + 8 <= n; i += 8) {
+		const __m256i widened_bits = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+		_mm256_storeu_ps(out + i, _mm256_castsi256_ps(_mm256_slli_epi32(widened_bits, 16)));
+	}
+#endif
+	for (; i < n; ++i) {
+		out[i] = in[i];
+	}
+}
+
+namespace storage_detail {
+
+template<typename Quantized>
+inline void pack_quantized(const typename Quantized::widened_t* in, Quantized* out, std::size_t n, std::false_type) {
+	for (std::size_t i = 0; i < n; ++i) {
+		out[i] = Quantized(in[i]);
+	}
+}
+
+template<typename Quantized>
+inline void unpack_quantized(const Quantized* in, typename Quantized::widened_t* out, std::size_t n, std::false_type) {
+	for (std::size_t i = 0; i < n; ++i) {
+		out[i] = static_cast<typename Quantized::widened_t>(in[i]);
+	}
+}
+
+// int16 has an AVX2 path. Both paths multiply by inverse_resolution and round to
+// nearest even, so they produce identical raw values. max_ps returns its second
+// operand for NaN, which clamps NaN to the lowest raw value like quantize does.
+template<typename Quantized>
+inline void pack_quantized(const float* in, Quantized* out, std::size_t n, std::true_type) {
+	std::size_t i = 0;
+#if defined(__AVX2__)
+	const __m256 offset = _mm256_set1_ps(Quantized::offset);
+	const __m256 inv_resolution = _mm256_set1_ps(Quantized::inverse_resolution);
+	const __m256 lowest = _mm256_set1_ps(-32768.0f);
+	const __m256 highest = _mm256_set1_ps(32767.0f);
+	for (; i + 16 <= n; i += 16) {
+		__m256i results[2];
+		for (int half_block = 0; half_block < 2; ++half_block) {
+			const __m256 scaled = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(in + i + 8 * half_block), offset), inv_resolution);
+			results[half_block] = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(scaled, lowest), highest));
+		}
+		const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(results[0], results[1]), 0xD8);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
+	}
+#endif
+	pack_quantized(in + i, out + i, n - i, std::false_type());
+}
+
+template<typename Quantized>
+inline void unpack_quantized(const Quantized* in, float* out, std::size_t n, std::true_type) {
+	std::size_t i = 0;
+#if defined(__AVX2__)
+	const __m256 offset = _mm256_set1_ps(Quantized::offset);
+	const __m256 resolution = _mm256_set1_ps(Quantized::resolution);
+	for (; i + 8 <= n; i += 8) {
+		const __m256i raw = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+		_mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(raw), resolution), offset));
+	}
+#endif
+	unpack_quantized(in + i, out + i, n - i, std::false_type());
+}
+
+template<typename Int>
+using is_int16 = std::integral_constant<bool, std::is_same<Int, std::int16_t>::value>;
+
+}
+
+// Quantized kernels take values of the type's widened_t, so quantized<int32_t, ...>
+// reads and writes double and keeps the precision its 32 bits hold.
+template<typename Int, typename Resolution, typename Offset>
+inline void pack(const typename quantized<Int, Resolution, Offset>::widened_t* in, quantized<Int, Resolution, Offset>* out, std::size_t n) {
+	storage_detail::pack_quantized(in, out, n, storage_detail::is_int16<Int>());
+}
+
+template<typename Int, typename Resolution, typename Offset>
+inline void unpack(const quantized<Int, Resolution, Offset>* in, typename quantized<Int, Resolution, Offset>::widened_t* out, std::size_t n) {
+	storage_detail::unpack_quantized(in, out, n, storage_detail::is_int16<Int>());
+}
+
+template<typename Unit>
+inline void pack(const quantity<Unit, float>* in, half* out, std::size_t n) {
+	pack(values_of(in), out, n);
+}
+
+template<typename Unit>
+inline void unpack(const quantity<Unit, half>* in, float* out, std::size_t n) {
+	unpack(values_of(in), out, n);
+}
+
+template<typename Unit>
+inline void pack(const quantity<Unit, float>* in, bfloat16* out, std::size_t n) {
+	pack(values_of(in), out, n);
+}
+
+template<typename Unit>
+inline void unpack(const quantity<Unit, bfloat16>* in, float* out, std::size_t n) {
+	unpack(values_of(in), out, n);
+}
+
+template<typename Unit, typename Int, typename Resolution, typename Offset>
+inline void pack(const quantity<Unit, typename quantized<Int, Resolution, Offset>::widened_t>* in, quantized<Int, Resolution, Offset>* out, std::size_t n) {
+	pack(values_of(in), out, n);
+}
+
+template<typename Unit, typename Int, typename Resolution, typename Offset>
+inline void unpack(const quantity<Unit, quantized<Int, Resolution, Offset>>* in, typename quantized<Int, Resolution, Offset>::widened_t* out, std::size_t n) {
+	unpack(values_of(in), out, n);
+}
+
+}
+
+namespace storage_tests {
+	using namespace unt;
+
+	using m = si::units::meter;
+	using millimeter_int16 = quantized<std::int16_t, std::ratio<1, 1000>>;
+
+	static_assert(sizeof(quantity<m, half>) == 2, "");
+	static_assert(sizeof(quantity<m, bfloat16>) == 2, "");
+	static_assert(sizeof(quantity<m, millimeter_int16>) == 2, "");
+	static_assert(std::is_standard_layout<quantity<m, half>>::value, "");
+
+	template<typename T>
+	using result_t = typename std::remove_cv<T>::type;
+
+	static_assert(std::is_same<result_t<decltype(std::declval<quantity<m, half>>() + std::declval<quantity<m, half>>())>, quantity<m, float>>::value, "");
+	static_assert(std::is_same<result_t<decltype(std::declval<quantity<m, bfloat16>>() * std::declval<quantity<m, bfloat16>>())>, quantity<m::power<2>, float>>::value, "");
+	static_assert(std::is_same<result_t<decltype(std::declval<quantity<m, millimeter_int16>>() - std::declval<quantity<m, millimeter_int16>>())>, quantity<m, float>>::value, "");
+	static_assert(std::is_same<decltype(widen(std::declval<quantity<m, half>>())), quantity<m, float>>::value, "");
+
+	static_assert(static_cast<float>(millimeter_int16::from_raw(1500)) > 1.4999f && static_cast<float>(millimeter_int16::from_raw(1500)) < 1.5001f, "");
+	static_assert(millimeter_int16::max > 32.7f && millimeter_int16::max < 32.8f, "");
+	static_assert(std::is_same<quantized<std::int32_t, std::ratio<1, 1000>>::widened_t, double>::value, "");
+
+	// Typed bulk overloads resolve for quantity arrays; 32-bit quantized data goes through double.
+	static_assert(std::is_void<decltype(pack(std::declval<const quantity<m, float>*>(), std::declval<half*>(), 0))>::value, "");
+	static_assert(std::is_void<decltype(unpack(std::declval<const quantity<m, millimeter_int16>*>(), std::declval<float*>(), 0))>::value, "");
+	static_assert(std::is_void<decltype(pack(std::declval<const quantity<m, double>*>(), std::declval<quantized<std::int32_t, std::ratio<1, 1000>>*>(), 0))>::value, "");
+}
@@ -0,0 +1,256 @@
+#pragma once
+#include <cstdint>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+#include <gcem.hpp>
+
+#include "units.hpp"
+
+namespace unt {
+
+template<typename...>
+struct void_type {
+	using type = void;
+};
+
+// A base that declares `reference` and `factor` is convertible: one of it equals
+// factor * reference. Bases without them are their own root.
+template<typename Base, typename = void>
+struct is_convertible_base : std::false_type {};
+
+template<typename Base>
+struct is_convertible_base<Base, typename void_type<typename Base::reference, typename Base::factor>::type> : std::true_type {};
+
+template<typename Base, typename = void>
+struct base_reference {
+	using root = Base;
+	static constexpr double factor = 1.0;
+};
+
+template<typename Base>
+struct base_reference<Base, typename std::enable_if<is_convertible_base<Base>::value>::type> {
+	using root = typename base_reference<typename Base::reference>::root;
+	static constexpr double factor = static_cast<double>(Base::factor::num) / static_cast<double>(Base::factor::den) * base_reference<typename Base::reference>::factor;
+};
+
+template<typename Base, typename Enable>
+constexpr double base_reference<Base, Enable>::factor;
+
+template<typename Base>
+constexpr double base_reference<Base, typename std::enable_if<is_convertible_base<Base>::value>::type>::factor;
+
+constexpr double factor_pow(double x, intmax_t num, intmax_t den) {
+	return x == 1.0 ? 1.0 :
+		den != 1 ? gcem::pow(x, static_cast<double>(num) / static_cast<double>(den)) :
+		num < 0 ? 1.0 / factor_pow(x, -num, 1) :
+		num == 0 ? 1.0 :
+		x * factor_pow(x, num - 1, 1);
+}
+
+// Splits a dim_set into its dims on root bases, which keep their sorted order,
+// and its dims on convertible bases, in one pass.
+template<typename DimSet, typename Kept = dim_set<>, typename Converted = dim_set<>>
+struct split_convertible;
+
+template<typename Kept, typename Converted>
+struct split_convertible<dim_set<>, Kept, Converted> {
+	using kept = Kept;
+	using converted = Converted;
+};
+
+template<typename Base, intmax_t ExpNum, intmax_t ExpDen, typename... RestDims, typename... KeptDims, typename... ConvertedDims>
+struct split_convertible<dim_set<dim<Base, ExpNum, ExpDen>, RestDims...>, dim_set<KeptDims...>, dim_set<ConvertedDims...>> {
+private:
+	using next = typename std::conditional<is_convertible_base<Base>::value,
+		split_convertible<dim_set<RestDims...>, dim_set<KeptDims...>, dim_set<ConvertedDims..., dim<Base, ExpNum, ExpDen>>>,
+		split_convertible<dim_set<RestDims...>, dim_set<KeptDims..., dim<Base, ExpNum, ExpDen>>, dim_set<ConvertedDims...>>
+	>::type;
+public:
+	using kept = typename next::kept;
+	using converted = typename next::converted;
+};
+
+// Rewrites the convertible dims in terms of root bases and merges them into the
+// sorted accumulator, accumulating the conversion factor.
+template<typename DimSet, typename Acc>
+struct root_dims_merge;
+
+template<typename Acc>
+struct root_dims_merge<dim_set<>, Acc> {
+	using result = Acc;
+	static constexpr double factor = 1.0;
+};
+
+template<typename Base, intmax_t ExpNum, intmax_t ExpDen, typename... RestDims, typename Acc>
+struct root_dims_merge<dim_set<dim<Base, ExpNum, ExpDen>, RestDims...>, Acc> {
+private:
+	using reference = base_reference<Base>;
+	using next = root_dims_merge<dim_set<RestDims...>, dim_set_mul<Acc, dim_set<dim<typename reference::root, ExpNum, ExpDen>>>>;
+public:
+	using result = typename next::result;
+	static constexpr double factor = factor_pow(reference::factor, ExpNum, ExpDen) * next::factor;
+};
+
+template<typename Acc>
+constexpr double root_dims_merge<dim_set<>, Acc>::factor;
+
+template<typename Base, intmax_t ExpNum, intmax_t ExpDen, typename... RestDims, typename Acc>
+constexpr double root_dims_merge<dim_set<dim<Base, ExpNum, ExpDen>, RestDims...>, Acc>::factor;
+
+// Rewrites a dim_set in terms of root bases. Dims that are already on a root base
+// pass through untouched, so a unit with no convertible base costs one linear
+// pass, and each convertible dim costs one merge into the rest.
+template<typename DimSet>
+struct root_dims_helper {
+private:
+	using split = split_convertible<DimSet>;
+	using merge = root_dims_merge<typename split::converted, typename split::kept>;
+public:
+	using result = typename merge::result;
+	static constexpr double factor = merge::factor;
+};
+
+template<typename DimSet>
+constexpr double root_dims_helper<DimSet>::factor;
+
+template<typename DimSet>
+using root_dims = typename root_dims_helper<DimSet>::result;
+
+// Conversion factors go through the root bases instead of a table per pair of
+// systems, so declaring a base costs one entry no matter how many systems exist.
+template<typename FromUnit, typename ToUnit>
+struct conversion {
+	static_assert(std::is_same<root_dims<typename FromUnit::dims>, root_dims<typename ToUnit::dims>>::value, "Cannot convert between different dimensions.");
+private:
+	using scale_ratio = std::ratio_subtract<typename FromUnit::log_10_scale_ratio, typename ToUnit::log_10_scale_ratio>;
+public:
+	static constexpr double factor =
+		root_dims_helper<typename FromUnit::dims>::factor / root_dims_helper<typename ToUnit::dims>::factor *
+		factor_pow(10.0, scale_ratio::num, scale_ratio::den);
+};
+
+template<typename FromUnit, typename ToUnit>
+constexpr double conversion<FromUnit, ToUnit>::factor;
+
+template<typename FromUnit, typename ToUnit>
+struct convertible : std::is_same<root_dims<typename FromUnit::dims>, root_dims<typename ToUnit::dims>> {};
+
+// Floating point values keep their type, so float data stays float. Storage types
+// such as half convert through their arithmetic type (+value, e.g. float). Integer
+// values convert to double, since conversion factors are rarely integral.
+template<typename ValueType>
+using converted_value_t = typename std::conditional<std::is_floating_point<decltype(+std::declval<ValueType>())>::value,
+	decltype(+std::declval<ValueType>()),
+	double
+>::type;
+
+template<typename ToUnit, typename Unit, typename ValueType>
+constexpr auto convert(const quantity<Unit, ValueType>& q) -> quantity<ToUnit, converted_value_t<ValueType>> {
+	return quantity<ToUnit, converted_value_t<ValueType>>(
+		static_cast<converted_value_t<ValueType>>(q.value) * static_cast<converted_value_t<ValueType>>(conversion<Unit, ToUnit>::factor));
+}
+
+template<typename ToDimSet, intmax_t ToExpNum, intmax_t ToExpDen, typename Unit, typename ValueType>
+constexpr auto convert(const quantity<Unit, ValueType>& q, const unit<ToDimSet, ToExpNum, ToExpDen>&) -> decltype(convert<unit<ToDimSet, ToExpNum, ToExpDen>>(q)) {
+	return convert<unit<ToDimSet, ToExpNum, ToExpDen>>(q);
+}
+
+}
+
+// Namespace-scope constexpr variables have internal linkage before C++17,
+// which keeps them from being exported by a module.
+#if __cplusplus >= 201703L
+	#define UNITS_INSTANCE inline constexpr
+#else
+	#define UNITS_INSTANCE constexpr
+#endif
+
+// The declaration macros expand into base, base_dim, units and instances
+// namespaces nested in the namespace they are used from.
+
+// Bases of a system share its sort order and are ordered among themselves by type hash.
+#define UNITS_DECLARE_SYSTEM(order) \
+namespace base { \
+	constexpr intmax_t system_sort_order = (order); \
+}
+
+#define UNITS_DECLARE_BASE_COMMON(name) \
+namespace base_dim { \
+	using name = unt::dim<base::name>; \
+} \
+namespace units { \
+	using name = unt::unit<unt::dim_set<unt::dim<base::name>>>; \
+} \
+namespace instances { \
+	UNITS_INSTANCE auto name = units::name::instance(); \
+}
+
+#define UNITS_DECLARE_ORDERED_BASE(name, order) \
+namespace base { \
+	struct name { \
+		static constexpr intmax_t sort_order = (order); \
+	}; \
+} \
+UNITS_DECLARE_BASE_COMMON(name)
+
+#define UNITS_DECLARE_BASE(name) \
+UNITS_DECLARE_ORDERED_BASE(name, base::system_sort_order)
+
+// One `name` is factor_num / factor_den of `reference_base`, which may belong to another system.
+#define UNITS_DECLARE_CONVERTIBLE_BASE(name, reference_base, factor_num, factor_den) \
+namespace base { \
+	struct name { \
+		static constexpr intmax_t sort_order = system_sort_order; \
+		using reference = reference_base; \
+		using factor = std::ratio<(factor_num), (factor_den)>; \
+	}; \
+} \
+UNITS_DECLARE_BASE_COMMON(name)
+
+#define UNITS_DECLARE_PREFIX(name, base_10_power) \
+namespace units { \
+	using name = unt::unit<unt::dim_set<>, base_10_power>; \
+} \
+namespace instances { \
+	UNITS_INSTANCE auto name = units::name::instance(); \
+}
+
+#define UNITS_DECLARE_DERIVED(name, unit_expression) \
+namespace instances { \
+	UNITS_INSTANCE auto name = decltype(unit_expression)::instance(); \
+} \
+namespace units { \
+	using name = decltype(instances::name)::type; \
+}
+
+namespace system_tests {
+	namespace pixels {
+		UNITS_DECLARE_SYSTEM(1000)
+		UNITS_DECLARE_BASE(pixel)
+		UNITS_DECLARE_CONVERTIBLE_BASE(tile, base::pixel, 16, 1)
+	}
+
+	namespace currency {
+		UNITS_DECLARE_SYSTEM(1001)
+		UNITS_DECLARE_BASE(euro)
+		UNITS_DECLARE_BASE(dollar)
+		UNITS_DECLARE_CONVERTIBLE_BASE(cent, base::dollar, 1, 100)
+	}
+
+	using namespace pixels::instances;
+	using namespace currency::instances;
+
+	static_assert(unt::dim_cmp<pixels::base_dim::pixel, currency::base_dim::euro>::lt, "");
+	static_assert(unt::dim_cmp<currency::base_dim::euro, currency::base_dim::dollar>::ne, "");
+
+	constexpr auto cost = 3.0 * euro / pixel.pow<2>;
+	static_assert(unt::convert(cost, euro / tile.pow<2>).value == 768.0, "");
+	static_assert(unt::convert(250 * cent, dollar).value == 2.5, "");
+	static_assert(std::is_same<decltype(unt::convert(2.0f * tile, pixel)), unt::quantity<pixels::units::pixel, float>>::value, "");
+	static_assert(unt::convert(2.0f * tile, pixel).value == 32.0f, "");
+	static_assert(std::is_same<decltype(unt::convert(250 * cent, dollar)), unt::quantity<currency::units::dollar, double>>::value, "");
+	static_assert(unt::convertible<currency::units::cent, currency::units::dollar>::value, "");
+	static_assert(!unt::convertible<currency::units::euro, currency::units::dollar>::value, "");
+}
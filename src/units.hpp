@@ -48,7 +48,7 @@ struct dim_mul_helper {
 template<typename Base, intmax_t ExpNumA, intmax_t ExpDenA, intmax_t ExpNumB, intmax_t ExpDenB>
 struct dim_mul_helper<dim<Base, ExpNumA, ExpDenA>, dim<Base, ExpNumB, ExpDenB>> {
 private:
-	using new_ratio = std::ratio_add<std::ratio<ExpNumA, ExpNumB>, std::ratio<ExpDenA, ExpDenB>>;
+	using new_ratio = std::ratio_add<std::ratio<ExpNumA, ExpDenA>, std::ratio<ExpNumB, ExpDenB>>;
 public:
 	using result = dim<Base, new_ratio::num, new_ratio::den>;
 };
@@ -123,6 +123,12 @@ struct dim_set_pow_helper<dim_set<Dims...>, ExpNum, ExpDen> {
 	using result = dim_set<typename Dims::template pow<ExpNum, ExpDen>...>;
 };
 
+// Raising to the power zero leaves no dimension behind, not a set of zero exponents.
+template<intmax_t ExpDen, typename... Dims>
+struct dim_set_pow_helper<dim_set<Dims...>, 0, ExpDen> {
+	using result = dim_set<>;
+};
+
 template<typename DimSet, intmax_t ExpNum, intmax_t ExpDen = 1>
 using dim_set_pow = typename dim_set_pow_helper<DimSet, ExpNum, ExpDen>::result;
 
@@ -147,16 +153,18 @@ struct dim_set_mul_helper<dim_set<>, dim_set<FirstDimB, RestDimsB...>, dim_set<D
 template<typename FirstDimA, typename... RestDimsA, typename FirstDimB, typename... RestDimsB, typename... DimsP>
 struct dim_set_mul_helper<dim_set<FirstDimA, RestDimsA...>, dim_set<FirstDimB, RestDimsB...>, dim_set<DimsP...>> {
 	using cmp_first = dim_cmp<FirstDimA, FirstDimB>;
-	using result = typename std::conditional<cmp_first::eq,
+	// Select the next step before asking for its result, so only one branch is instantiated.
+	using next = typename std::conditional<cmp_first::eq,
 		typename std::conditional<std::is_same<typename dim_mul<FirstDimA, FirstDimB>::exponent, std::ratio<0,1>>::value,
-			typename dim_set_mul_helper<dim_set<RestDimsA...>, dim_set<RestDimsB...>, dim_set<DimsP..., dim_mul<FirstDimA, FirstDimB>>>::result,
-			typename dim_set_mul_helper<dim_set<RestDimsA...>, dim_set<RestDimsB...>, dim_set<DimsP...>>::result
+			dim_set_mul_helper<dim_set<RestDimsA...>, dim_set<RestDimsB...>, dim_set<DimsP...>>,
+			dim_set_mul_helper<dim_set<RestDimsA...>, dim_set<RestDimsB...>, dim_set<DimsP..., dim_mul<FirstDimA, FirstDimB>>>
 		>::type,
 		typename std::conditional<cmp_first::lt,
-			typename dim_set_mul_helper<dim_set<RestDimsA...>, dim_set<FirstDimB, RestDimsB...>, dim_set<DimsP..., FirstDimA>>::result,
-			typename dim_set_mul_helper<dim_set<FirstDimA, RestDimsA...>, dim_set<RestDimsB...>, dim_set<DimsP..., FirstDimB>>::result
+			dim_set_mul_helper<dim_set<RestDimsA...>, dim_set<FirstDimB, RestDimsB...>, dim_set<DimsP..., FirstDimA>>,
+			dim_set_mul_helper<dim_set<FirstDimA, RestDimsA...>, dim_set<RestDimsB...>, dim_set<DimsP..., FirstDimB>>
 		>::type
 	>::type;
+	using result = typename next::result;
 };
 
 template<typename SetA, typename SetB>
@@ -255,6 +263,15 @@ struct unit {
 	constexpr static scale<Num, Den> scl = scale<Num, Den>::instance();
 };
 
+// Specialize to let quantity convert to and from another type. `convert` maps a
+// From to the To value (or value_t when To is a quantity); `implicit` chooses
+// between an implicit and an explicit conversion.
+template<typename From, typename To, typename = void>
+struct quantity_conversion {
+	static constexpr bool exists = false;
+	static constexpr bool implicit = false;
+};
+
 template<typename Unit, typename ValueType = double>
 struct quantity {
 	using type = quantity<Unit, ValueType>;
@@ -267,6 +284,22 @@ struct quantity {
 
 	constexpr quantity(const quantity& other) : value(other.value) {};
 
+	template<typename Other, typename std::enable_if<quantity_conversion<Other, type>::exists && quantity_conversion<Other, type>::implicit, int>::type = 0>
+	constexpr quantity(const Other& other) : value(quantity_conversion<Other, type>::convert(other)) {};
+
+	template<typename Other, typename std::enable_if<quantity_conversion<Other, type>::exists && !quantity_conversion<Other, type>::implicit, int>::type = 0>
+	explicit constexpr quantity(const Other& other) : value(quantity_conversion<Other, type>::convert(other)) {};
+
+	template<typename Other, typename std::enable_if<quantity_conversion<type, Other>::exists && quantity_conversion<type, Other>::implicit, int>::type = 0>
+	constexpr operator Other() const {
+		return quantity_conversion<type, Other>::convert(*this);
+	}
+
+	template<typename Other, typename std::enable_if<quantity_conversion<type, Other>::exists && !quantity_conversion<type, Other>::implicit, int>::type = 0>
+	explicit constexpr operator Other() const {
+		return quantity_conversion<type, Other>::convert(*this);
+	}
+
 	template<typename RHSUnit, typename RHSValueType>
 	constexpr bool operator==(const quantity<RHSUnit, RHSValueType>& rhs) const {
 		static_assert(Unit::template equal<RHSUnit>::value == true, "Cannot compare different units.");
@@ -325,7 +358,7 @@ struct quantity {
 	}
 
 	template<typename RHSDimTuple, intmax_t RHSExpNum, intmax_t RHSExpDen>
-	constexpr auto operator/(const unit<RHSDimTuple, RHSExpNum, RHSExpDen>& rhs) -> quantity<typename Unit::template mul<unit<RHSDimTuple, RHSExpNum, RHSExpDen>>, ValueType> const {
+	constexpr auto operator/(const unit<RHSDimTuple, RHSExpNum, RHSExpDen>& rhs) -> quantity<typename Unit::template div<unit<RHSDimTuple, RHSExpNum, RHSExpDen>>, ValueType> const {
 		return quantity<typename Unit::template div<unit<RHSDimTuple, RHSExpNum, RHSExpDen>>, ValueType>(value);
 	}
 
@@ -340,6 +373,14 @@ struct is_quantity<quantity<Unit, ValueType>> : std::true_type{};
 template<typename T>
 using enforce_quantity = typename std::enable_if<is_quantity<T>::value, T>::type;
 
+// quantity<U, T> is standard layout with a single member, so an array of it
+// shares the layout of an array of T. Bulk kernels read quantity arrays through this.
+template<typename Unit, typename ValueType>
+inline const ValueType* values_of(const quantity<Unit, ValueType>* q) {
+	static_assert(sizeof(quantity<Unit, ValueType>) == sizeof(ValueType) && std::is_standard_layout<quantity<Unit, ValueType>>::value, "quantity must have the layout of its value.");
+	return reinterpret_cast<const ValueType*>(q);
+}
+
 template<typename T>
 struct is_undimensioned : std::integral_constant<bool, !(is_quantity<T>{} || is_unit<T>{})> {};
 